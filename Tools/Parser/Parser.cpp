@@ -16,12 +16,70 @@
 
 #include "Parser.h"
 #include <kerlog.h>
+#include <atomic>
+#include <thread>
+#include <system_error>
+#include <charconv>
+#include <cstdio>
+#include <zlib.h>
 
 Parse::Parser Parse::defaultParser;
 
 
 Parse::Parser::Parser(): _keyFile(nullptr, [](GKeyFile* ptr){ if (ptr != nullptr)g_key_file_free(ptr); }) {}
 
+/*!
+ * Check if file starts with gzip magic bytes
+ * @param file Path to file to be checked
+ * @return true if file is gzip compressed, false otherwise (including not existing files)
+ */
+bool isGzipCompressed(const std::string& file)
+{
+    std::unique_ptr<FILE, int(*)(FILE*)> stream(fopen(file.c_str(), "rb"), fclose);
+    if(!stream)
+        return false;
+    unsigned char magic[2] = {};
+    return fread(magic, 1, sizeof(magic), stream.get()) == sizeof(magic) && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+
+/*!
+ * Decompress gzip file chunk by chunk into memory
+ * @param file Path to compressed file
+ * @param data Decompressed file content
+ * @param maxSize Maximal size of decompressed content
+ * @return true if decompressed successfully, false otherwise (including truncated or corrupted streams and
+ *         content exceeding maxSize)
+ */
+bool decompressGzipFile(const std::string& file, std::string& data, size_t maxSize)
+{
+    constexpr size_t chunkSize = 64 * 1024;
+    gzFile stream = gzopen(file.c_str(), "rb");
+    if(stream == nullptr)
+        return false;
+    gzbuffer(stream, chunkSize);
+    data.clear();
+    std::unique_ptr<char[]> chunk(new char[chunkSize]);
+    int readBytes;
+    bool tooLarge = false;
+    while((readBytes = gzread(stream, chunk.get(), chunkSize)) > 0)
+    {
+        if (size_t(readBytes) > maxSize - data.size())
+        {
+            tooLarge = true;
+            break;
+        }
+        data.append(chunk.get(), size_t(readBytes));
+    }
+    int streamError = Z_OK;
+    gzerror(stream, &streamError);
+    int closeError = gzclose(stream);
+    if (tooLarge)
+        data.clear();
+    return !tooLarge && readBytes == 0 && streamError == Z_OK && closeError == Z_OK;
+}
+
+
 Parse::ErrorCode Parse::Parser::loadConfigFile(const std::string& file)
 {
     KERLOG_DEBUG("Loading key file with name/path" + file + "' @ " + std::to_string((uint64_t) this));
@@ -37,17 +95,93 @@ Parse::ErrorCode Parse::Parser::loadConfigFile(const std::string& file)
         //GCOV_EXCL_STOP
     }
     g_autoptr(GError) glibError = nullptr;
-    if (!g_key_file_load_from_file(keyFile.get(), file.c_str(), G_KEY_FILE_NONE, &glibError))
+    gboolean loaded;
+    if (isGzipCompressed(file))
+    {
+        KERLOG_DEBUG("Key file with name/path '" + file + "' is gzip compressed");
+        std::string data;
+        if (!decompressGzipFile(file, data, maxDecompressedSize))
+        {
+            KERLOG_ERROR("Error decompressing key file '" + file + "'");
+            return LoadFailed;
+        }
+        loaded = g_key_file_load_from_data(keyFile.get(), data.data(), data.size(), G_KEY_FILE_NONE, &glibError);
+    }
+    else
+        loaded = g_key_file_load_from_file(keyFile.get(), file.c_str(), G_KEY_FILE_NONE, &glibError);
+    if (!loaded)
     {
         KERLOG_ERROR("Error loading key file: " + std::string(glibError->message));
         return LoadFailed;
     }
-    _keyFile = std::move(keyFile);
+    std::swap(_keyFile, keyFile);
+    ErrorCode validateError = validate();
+    if (validateError != Success)
+    {
+        KERLOG_ERROR("Key file with name/path '" + file + "' didn't pass validation: " + std::to_string(validateError));
+        std::swap(_keyFile, keyFile);
+        return validateError;
+    }
     KERLOG_DEBUG("Key file with name/path '" + file + "' loaded. Returning Success");
     return Success;
 }
 
 
+Parse::ErrorCode Parse::Parser::validate()
+{
+    std::vector<std::any> staged(_constraints.size());
+    for (size_t i = 0; i < _constraints.size(); ++i)
+    {
+        ErrorCode checkError = _constraints[i].check(*this, staged[i]);
+        if (checkError != Success)
+        {
+            KERLOG_ERROR("Option '" + _constraints[i].key + "' from group '" + _constraints[i].groupName
+                         + "' is invalid. Returning value: " + std::to_string(checkError));
+            return checkError;
+        }
+    }
+    for (size_t i = 0; i < _constraints.size(); ++i)
+        _constraints[i].store(staged[i]);
+    return Success;
+}
+
+
+std::vector<std::pair<Parse::Parser, Parse::ErrorCode>>
+Parse::Parser::loadConfigFiles(const std::vector<std::string>& files, size_t threadCount)
+{
+    KERLOG_DEBUG("Loading " + std::to_string(files.size()) + " key files");
+    std::vector<std::pair<Parser, ErrorCode>> result(files.size());
+    if (threadCount == 0)
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    threadCount = std::min(threadCount, files.size());
+
+    std::atomic<size_t> nextFile(0);
+    auto worker = [&files, &result, &nextFile]()
+    {
+        for (size_t i = nextFile++; i < files.size(); i = nextFile++)
+            result[i].second = result[i].first.loadConfigFile(files[i]);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    try
+    {
+        for (size_t i = 1; i < threadCount; ++i)
+            workers.emplace_back(worker);
+    }
+    catch (const std::system_error &)
+    {
+        KERLOG_DEBUG("Started " + std::to_string(workers.size()) + " of " + std::to_string(threadCount - 1) +
+                     " loading threads, the rest of files are loaded by the calling thread");
+    }
+    worker();
+    for (auto &thread: workers)
+        thread.join();
+    KERLOG_DEBUG("Loading " + std::to_string(files.size()) + " key files completed");
+    return result;
+}
+
+
 Parse::ErrorCode
 Parse::Parser::glibErrorCheck(const std::string& group_name, const std::string& key, GError_autoptr error) const
 {
@@ -150,6 +284,105 @@ std::pair<Parse::GroupInfo, Parse::ErrorCode> Parse::Parser::parseGroup(const st
 }
 
 
+Parse::ErrorCode Parse::Parser::createIfNotLoaded()
+{
+    if(_keyFile)
+        return Success;
+    KERLOG_DEBUG("Creating empty key file @ " + std::to_string((uint64_t) this));
+    _keyFile.reset(g_key_file_new());
+    if(!_keyFile)
+    {   //GCOV_EXCL_START
+        KERLOG_ERROR("Error creating new key file: " + std::to_string(GlibError));
+        return GlibError;
+        //GCOV_EXCL_STOP
+    }
+    return Success;
+}
+
+
+Parse::ErrorCode
+Parse::Parser::setStringToFile(const std::string& group_name, const std::string& key, const std::string& value)
+{
+    KERLOG_DEBUG("Setting single key string " + key + " in group " + group_name + " @ " + std::to_string((uint64_t) this));
+    ErrorCode createError = createIfNotLoaded();
+    if(createError != Success)
+        return createError;
+    g_key_file_set_string(_keyFile.get(), group_name.c_str(), key.c_str(), value.c_str());
+    return Success;
+}
+
+
+Parse::ErrorCode Parse::Parser::setStringList(const std::string& group_name, const std::string& key,
+                                              const std::vector<std::string>& values)
+{
+    KERLOG_DEBUG("Setting key strings " + key + " in group " + group_name + " @ " + std::to_string((uint64_t) this));
+    ErrorCode createError = createIfNotLoaded();
+    if(createError != Success)
+        return createError;
+    std::vector<const gchar*> list;
+    list.reserve(values.size());
+    for(auto &value: values)
+        list.push_back(value.c_str());
+    g_key_file_set_string_list(_keyFile.get(), group_name.c_str(), key.c_str(), list.data(), list.size());
+    return Success;
+}
+
+
+Parse::ErrorCode Parse::Parser::removeKey(const std::string& group_name, const std::string& key)
+{
+    KERLOG_DEBUG("Removing key " + key + " from group " + group_name + " @ " + std::to_string((uint64_t) this));
+    if(!_keyFile)
+    {
+        KERLOG_ERROR("_keyFile is not loaded. Returning FileNotLoaded");
+        return FileNotLoaded;
+    }
+    g_autoptr(GError) error = nullptr;
+    if(!g_key_file_remove_key(_keyFile.get(), group_name.c_str(), key.c_str(), &error))
+        return glibErrorCheck(group_name, key, error);
+    return Success;
+}
+
+
+std::pair<std::string, Parse::ErrorCode> Parse::Parser::toData() const
+{
+    KERLOG_DEBUG("Rendering key file @ " + std::to_string((uint64_t) this));
+    if(!_keyFile)
+    {
+        KERLOG_ERROR("_keyFile is not loaded. Returning FileNotLoaded");
+        return {"", FileNotLoaded};
+    }
+    gsize length = 0;
+    g_autoptr(GError) error = nullptr;
+    std::unique_ptr<gchar, void(*)(gchar*)> data(g_key_file_to_data(_keyFile.get(), &length, &error),
+                                                 [](gchar* ptr) { g_free(ptr); });
+    if(!data)
+    {   //GCOV_EXCL_START
+        KERLOG_ERROR("Error rendering key file: " + std::string(error->message) + ".Returning value: GlibError");
+        return {"", GlibError};
+        //GCOV_EXCL_STOP
+    }
+    return {std::string(data.get(), length), Success};
+}
+
+
+Parse::ErrorCode Parse::Parser::saveConfigFile(const std::string& file) const
+{
+    KERLOG_DEBUG("Saving key file with name/path '" + file + "' @ " + std::to_string((uint64_t) this));
+    if(!_keyFile)
+    {
+        KERLOG_ERROR("_keyFile is not loaded. Returning FileNotLoaded");
+        return FileNotLoaded;
+    }
+    g_autoptr(GError) error = nullptr;
+    if(!g_key_file_save_to_file(_keyFile.get(), file.c_str(), &error))
+    {
+        KERLOG_ERROR("Error saving key file: " + std::string(error->message) + ".Returning value: SaveFailed");
+        return SaveFailed;
+    }
+    KERLOG_DEBUG("Key file with name/path '" + file + "' saved. Returning Success");
+    return Success;
+}
+
 Parse::ErrorCode convertCheck(const std::string &str, char *pend)
 {
     if(pend != str)
@@ -268,4 +501,74 @@ std::pair<char, Parse::ErrorCode> Parse::Convert<char>::operator()(const std::st
     if(str.empty())
         return {' ', Success};
     return {{}, IncorrectFileContainment};
+}
+
+
+template <class T>
+std::pair<std::string, Parse::ErrorCode> toStringCommonType(T value)
+{
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+    // Enough for any integer and for the shortest round trip representation of long double
+    char buffer[64];
+    auto res = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    if(res.ec != std::errc())
+        return {"", Parse::OutOfRange}; //GCOV_EXCL_LINE
+    return {std::string(buffer, res.ptr), Parse::Success};
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<std::string>::operator()(const std::string &value) const
+{
+    return {value, Success};
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<int>::operator()(int value) const
+{
+    return toStringCommonType(value);
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<float>::operator()(float value) const
+{
+    return toStringCommonType(value);
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<double>::operator()(double value) const
+{
+    return toStringCommonType(value);
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<long double>::operator()(long double value) const
+{
+    return toStringCommonType(value);
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<long>::operator()(long value) const
+{
+    return toStringCommonType(value);
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<long long>::operator()(long long value) const
+{
+    return toStringCommonType(value);
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<unsigned long>::operator()(unsigned long value) const
+{
+    return toStringCommonType(value);
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<unsigned long long>::operator()(unsigned long long value) const
+{
+    return toStringCommonType(value);
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<bool>::operator()(bool value) const
+{
+    return {value ? "true" : "false", Success};
+}
+
+std::pair<std::string, Parse::ErrorCode> Parse::ToString<char>::operator()(char value) const
+{
+    if(value == '\n')
+        return {"\\n", Success};
+    return {std::string(1, value), Success};
 }
\ No newline at end of file
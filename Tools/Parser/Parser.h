@@ -22,6 +22,12 @@
 #include <algorithm>
 #include <TimeConversion.h>
 #include <memory>
+#include <vector>
+#include <functional>
+#include <any>
+#include <cassert>
+#include <array>
+#include <tuple>
 
 
 namespace Parse
@@ -37,6 +43,55 @@ namespace Parse
     class Convert
     {};
 
+    /*!
+     * @class is_fixed_size
+     * Checks if type is a fixed-size aggregate (std::array, std::pair, std::tuple) which is parsed from multiple
+     * values as a whole
+     */
+    template <typename T>
+    struct is_fixed_size : std::false_type {};
+
+    template <typename T, size_t N>
+    struct is_fixed_size<std::array<T, N>> : std::true_type {};
+
+    template <typename T, typename U>
+    struct is_fixed_size<std::pair<T, U>> : std::true_type {};
+
+    template <typename... Ts>
+    struct is_fixed_size<std::tuple<Ts...>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_fixed_size_v = is_fixed_size<T>::value;
+
+    /*!
+     * Type parseMultipleOptions returns: T itself for fixed-size aggregates, std::vector<T> otherwise
+     */
+    template <typename T>
+    using MultipleOptions = std::conditional_t<is_fixed_size_v<T>, T, std::vector<T>>;
+
+    /*!
+     * @class ToString
+     * Defines possible type conversions to std::string. Inverse of Convert
+     * @tparam T Type the value will be converted from
+     */
+    template <typename T>
+    class ToString
+    {};
+
+    /*!
+     * @class OptionHandle
+     * Index of option registered with Parser::addConstraint. Used to get validated value
+     * @tparam T Type of the option
+     */
+    template <typename T>
+    class OptionHandle
+    {
+        friend class Parser;
+        size_t _index;
+
+        explicit OptionHandle(size_t index) : _index(index) {}
+    };
+
     /*!
      *  @class Parser
      *  @brief Used to parse options from .ini file. See glib key-value file parser reference for details
@@ -60,6 +115,13 @@ namespace Parse
      *      1. If there's single "\" in any key, then can't parse.
      *      2. Recognizes empty string at the begin (";text" -> "", "text" ) but not at the end: ";text;" -> "", "text"
      *
+     *  Options can be changed with setOption/setMultipleOptions/removeKey and the result can be written back with
+     *  toData/saveConfigFile. If no file is loaded, the first setOption call creates an empty one.
+     *
+     *  Options can be validated at load time: every constraint registered with addConstraint is checked by
+     *  loadConfigFile (and by addConstraint itself if a file is already loaded), and converted values are stored,
+     *  so validatedOption never fails.
+     *
      *  @note Possible types to be parsed:
      *      - bool
      *      - std::string
@@ -72,6 +134,21 @@ namespace Parse
     {
         std::unique_ptr<GKeyFile,  void(*)(GKeyFile*)> _keyFile;
 
+        /*!
+         * @struct Constraint
+         * Option registered for load time validation
+         */
+        struct Constraint
+        {
+            std::string groupName;
+            std::string key;
+            std::shared_ptr<void> value; ///< Validated value of option type. Assigned in place, never moves
+            std::function<ErrorCode(const Parser&, std::any&)> check; ///< Parses and checks value, stages it
+            std::function<void(std::any&)> store; ///< Moves staged value to value
+        };
+
+        std::vector<Constraint> _constraints;
+
         /*!
          * @defgroup glibErrors
          * @retval GroupNotFound Group wasn't found
@@ -130,9 +207,55 @@ namespace Parse
         std::pair<std::vector<std::string>, ErrorCode>
         getStringList(const std::string& group_name, const std::string& key) const;
 
+        /*!
+         * Create empty key file if there's no loaded one
+         * @return Tools error code
+         * @retval Success
+         * @retval GlibError Creating new key file failed
+         */
+        ErrorCode createIfNotLoaded();
+
+        /*!
+         * Set single string. Escapes "\" and control symbols, but not separators
+         * @param group_name Group name to set value to. Created if doesn't exist
+         * @param key Key to set value to. Created if doesn't exist
+         * @param value String to be set
+         * @return Tools error code
+         * @retval Success
+         * @retval GlibError Creating new key file failed
+         */
+        ErrorCode setStringToFile(const std::string& group_name, const std::string& key, const std::string& value);
+
+        /*!
+         * Set list of strings. Escapes "\", control symbols and separators
+         * @param group_name Group name to set values to. Created if doesn't exist
+         * @param key Key to set values to. Created if doesn't exist
+         * @param values Strings to be set
+         * @return Tools error code
+         * @retval Success
+         * @retval GlibError Creating new key file failed
+         */
+        ErrorCode setStringList(const std::string& group_name, const std::string& key,
+                                const std::vector<std::string>& values);
+
+        /*!
+         * Check all registered constraints against loaded key file and store converted values if all of them pass
+         * @return Tools error code
+         * @retval Success
+         * @retval ConstraintViolated Value doesn't satisfy its constraint
+         * @copydetails glibErrors
+         * @copydetails convertErrors
+         */
+        ErrorCode validate();
+
 
     public:
 
+        /*!
+         * Maximal size of decompressed gzip config file. Protects from files inflating to exhaust memory
+         */
+        static constexpr size_t maxDecompressedSize = 64 * 1024 * 1024;
+
         /*!
          * Constructor
          */
@@ -152,15 +275,29 @@ namespace Parse
         { _keyFile = nullptr; }
 
         /*!
-         * Load config file
+         * Load config file. Gzip compressed files are detected by magic bytes and decompressed while reading
          * @param file Path to config file to be loaded
          * @return Tools error code
          * @retval Success
          * @retval GlibError Creating new key file failed
-         * @retval LoadFailed Error while loading key file
+         * @retval LoadFailed Error while loading key file or decompressed file exceeds maxDecompressedSize
+         * @retval ConstraintViolated Value doesn't satisfy registered constraint. Previous file stays loaded
+         * @copydetails glibErrors
+         * @copydetails convertErrors
          */
         ErrorCode loadConfigFile(const std::string& file = "Config.ini");
 
+        /*!
+         * Load several config files concurrently. Every file is loaded into its own Parser by a pool of worker threads
+         * @param files Paths to config files to be loaded
+         * @param threadCount Number of worker threads. 0 means std::thread::hardware_concurrency(). If a thread
+         *        can't be started, its files are loaded by the remaining ones, including the calling thread
+         * @return Vector of <parser, Tools error code> in the same order as files. Error codes are the same as
+         *         loadConfigFile returns
+         */
+        static std::vector<std::pair<Parser, ErrorCode>>
+        loadConfigFiles(const std::vector<std::string>& files, size_t threadCount = 0);
+
         /*!
          * Get vector of keys and values
          * @param group_name Group name to get keys and values from
@@ -187,6 +324,9 @@ namespace Parse
 
         /*!
          * Parse multiple options from key in group. Looks for separators
+         * @note If T is fixed-size aggregate (std::array, std::pair, std::tuple), the values are converted element by
+         *       element straight into T. Values count must be equal to aggregate size, otherwise
+         *       IncorrectFileContainment is returned
          * @tparam T Type to be parsed
          * @param group_name Group name to get value from
          * @param key Key to get value from
@@ -196,8 +336,117 @@ namespace Parse
          * @copydetails convertErrors
          */
         template <typename T>
-        std::pair<std::vector<T>, ErrorCode>
+        std::pair<MultipleOptions<T>, ErrorCode>
         parseMultipleOptions(const std::string& group_name, const std::string& key) const;
+
+        /*!
+         * Set single option. Value can be parsed back with parseSingleOption
+         * @tparam T Type of value to be set
+         * @param group_name Group name to set value to. Created if doesn't exist
+         * @param key Key to set value to. Created if doesn't exist
+         * @param value Value to be set
+         * @return Tools error code
+         * @retval Success
+         * @retval GlibError Creating new key file failed
+         */
+        template <typename T>
+        ErrorCode setOption(const std::string& group_name, const std::string& key, const T& value);
+
+        /*!
+         * Set multiple options separated with ";". Values can be parsed back with parseMultipleOptions
+         * @tparam T Type of values to be set
+         * @param group_name Group name to set values to. Created if doesn't exist
+         * @param key Key to set values to. Created if doesn't exist
+         * @param values Values to be set
+         * @return Tools error code
+         * @retval Success
+         * @retval GlibError Creating new key file failed
+         */
+        template <typename T>
+        ErrorCode setMultipleOptions(const std::string& group_name, const std::string& key, const std::vector<T>& values);
+
+        /*!
+         * Remove key from group
+         * @param group_name Group name to remove key from
+         * @param key Key to be removed
+         * @return Tools error code
+         * @retval Success
+         * @retval FileNotLoaded Config file isn't loaded
+         * @copydetails glibErrors
+         */
+        ErrorCode removeKey(const std::string& group_name, const std::string& key);
+
+        /*!
+         * Render loaded config to .ini format
+         * @return Tools error code and config content
+         * @retval Success
+         * @retval FileNotLoaded Config file isn't loaded
+         * @retval GlibError Glib error occurred
+         */
+        std::pair<std::string, ErrorCode> toData() const;
+
+        /*!
+         * Save config file. The whole content is rendered to single buffer and written at once
+         * @param file Path to config file to be saved
+         * @return Tools error code
+         * @retval Success
+         * @retval FileNotLoaded Config file isn't loaded
+         * @retval SaveFailed Error while saving key file
+         */
+        ErrorCode saveConfigFile(const std::string& file) const;
+
+        /*!
+         * Register option to be checked by every next loadConfigFile call. If a file is already loaded, the option
+         * is checked against it immediately
+         * @tparam T Type the option must be convertible to (must be default constructible)
+         * @param group_name Group name of the option
+         * @param key Key of the option
+         * @param predicate Additional check of converted value. Not called if empty
+         * @return Handle to get validated value with and Tools error code of the immediate check. The option is
+         *         registered anyway, on error its value is T() until the next successful loadConfigFile call
+         * @retval Success Value is valid or no file is loaded
+         * @retval ConstraintViolated Value doesn't satisfy the constraint
+         * @copydetails glibErrors
+         * @copydetails convertErrors
+         */
+        template <typename T>
+        std::pair<OptionHandle<T>, ErrorCode> addConstraint(const std::string& group_name, const std::string& key,
+                                                            std::function<bool(const T&)> predicate = nullptr);
+
+        /*!
+         * Register option to be checked by every next loadConfigFile call. Value must be in range [min, max]
+         * @tparam T Type the option must be convertible to
+         * @param group_name Group name of the option
+         * @param key Key of the option
+         * @param min Minimal allowed value
+         * @param max Maximal allowed value
+         * @return Handle and Tools error code (see addConstraint with predicate)
+         */
+        template <typename T>
+        std::pair<OptionHandle<T>, ErrorCode> addConstraint(const std::string& group_name, const std::string& key,
+                                                            T min, T max);
+
+        /*!
+         * Register option to be checked by every next loadConfigFile call. Value must be one of allowed values
+         * @tparam T Type the option must be convertible to
+         * @param group_name Group name of the option
+         * @param key Key of the option
+         * @param allowed Allowed values
+         * @return Handle and Tools error code (see addConstraint with predicate)
+         */
+        template <typename T>
+        std::pair<OptionHandle<T>, ErrorCode> addConstraint(const std::string& group_name, const std::string& key,
+                                                            std::vector<T> allowed);
+
+        /*!
+         * Get value validated by the last successful check of the option. T() if it hasn't passed any check yet
+         * @tparam T Type of the option
+         * @param handle Handle returned by addConstraint
+         * @return Reference to validated value. It stays valid for the parser lifetime and is updated in place by
+         *         every next successful loadConfigFile call
+         */
+        template <typename T>
+        const T& validatedOption(OptionHandle<T> handle) const;
     };
 
     extern Parser defaultParser;
@@ -207,18 +456,39 @@ namespace Parse
 template <typename T>
 std::pair<std::vector<T>, Parse::ErrorCode> Parse::Parser::multipleConvert(const std::vector<std::string> &ret) const
 {
-    std::vector<T> res;
-    res.reserve(ret.size());
-    errno = 0;
-    for(auto &str: ret)
+    if constexpr (timeConversion::TimeConverter::is_duration_v<T>)
     {
-        auto resConvert = Convert<T>()(str);
-        if (resConvert.second == Success)
-            res.emplace_back(std::move(resConvert.first));
-        else
-            return {{}, resConvert.second};
+        std::vector<std::string_view> strings(ret.begin(), ret.end());
+        std::vector<T> res(ret.size());
+        std::vector<ErrorCode> errors(ret.size());
+        if (timeConversion::TimeConverter::stringsToTimes(strings.data(), strings.size(), res.data(), errors.data()))
+            return {res, Success};
+        return {{}, *std::find_if(errors.begin(), errors.end(), [](ErrorCode error) { return error != Success; })};
+    }
+    else if constexpr (unitConversion::is_quantity_v<T>)
+    {
+        std::vector<std::string_view> strings(ret.begin(), ret.end());
+        std::vector<T> res(ret.size());
+        std::vector<ErrorCode> errors(ret.size());
+        if (unitConversion::stringsToQuantities(strings.data(), strings.size(), res.data(), errors.data()))
+            return {res, Success};
+        return {{}, *std::find_if(errors.begin(), errors.end(), [](ErrorCode error) { return error != Success; })};
+    }
+    else
+    {
+        std::vector<T> res;
+        res.reserve(ret.size());
+        errno = 0;
+        for(auto &str: ret)
+        {
+            auto resConvert = Convert<T>()(str);
+            if (resConvert.second == Success)
+                res.emplace_back(std::move(resConvert.first));
+            else
+                return {{}, resConvert.second};
+        }
+        return {res, Success};
     }
-    return {res, Success};
 }
 
 template <typename T>
@@ -235,13 +505,20 @@ std::pair<T, Parse::ErrorCode> Parse::Parser::parseSingleOption(const std::strin
 }
 
 template <typename T>
-std::pair<std::vector<T>, Parse::ErrorCode>
+std::pair<Parse::MultipleOptions<T>, Parse::ErrorCode>
 Parse::Parser::parseMultipleOptions(const std::string& group_name, const std::string& key) const
 {
     auto str = getStringList(group_name, key);
     if(str.second == Success)
     {
-        auto convertRes = multipleConvert<T>(str.first);
+        std::pair<MultipleOptions<T>, ErrorCode> convertRes;
+        if constexpr (is_fixed_size_v<T>)
+        {
+            errno = 0;
+            convertRes = Convert<T>()(str.first);
+        }
+        else
+            convertRes = multipleConvert<T>(str.first);
         if(convertRes.second != Success)
             return {{}, convertRes.second};
         return {std::move(convertRes.first), Success};
@@ -250,6 +527,90 @@ Parse::Parser::parseMultipleOptions(const std::string& group_name, const std::st
         return {{}, str.second};
 }
 
+template <typename T>
+Parse::ErrorCode Parse::Parser::setOption(const std::string& group_name, const std::string& key, const T& value)
+{
+    auto str = ToString<T>()(value);
+    if(str.second != Success)
+        return str.second;
+    return setStringToFile(group_name, key, str.first);
+}
+
+template <typename T>
+Parse::ErrorCode
+Parse::Parser::setMultipleOptions(const std::string& group_name, const std::string& key, const std::vector<T>& values)
+{
+    std::vector<std::string> strings;
+    strings.reserve(values.size());
+    for(auto &value: values)
+    {
+        auto str = ToString<T>()(value);
+        if(str.second != Success)
+            return str.second;
+        strings.emplace_back(std::move(str.first));
+    }
+    return setStringList(group_name, key, strings);
+}
+
+template <typename T>
+std::pair<Parse::OptionHandle<T>, Parse::ErrorCode>
+Parse::Parser::addConstraint(const std::string& group_name, const std::string& key,
+                             std::function<bool(const T&)> predicate)
+{
+    auto value = std::make_shared<T>();
+    Constraint constraint{group_name, key, value, [group_name, key, predicate](const Parser& parser, std::any& staged)
+    {
+        auto res = parser.parseSingleOption<T>(group_name, key);
+        if(res.second != Success)
+            return res.second;
+        if(predicate && !predicate(res.first))
+            return ConstraintViolated;
+        staged = std::move(res.first);
+        return Success;
+    }, [value](std::any& staged)
+    {
+        *value = std::move(*std::any_cast<T>(&staged));
+    }};
+
+    ErrorCode error = Success;
+    if (isOpen())
+    {
+        std::any staged;
+        error = constraint.check(*this, staged);
+        if (error == Success)
+            constraint.store(staged);
+    }
+    _constraints.push_back(std::move(constraint));
+    return {OptionHandle<T>(_constraints.size() - 1), error};
+}
+
+template <typename T>
+std::pair<Parse::OptionHandle<T>, Parse::ErrorCode>
+Parse::Parser::addConstraint(const std::string& group_name, const std::string& key, T min, T max)
+{
+    return addConstraint<T>(group_name, key, [min = std::move(min), max = std::move(max)](const T& value)
+    {
+        return !(value < min) && !(max < value);
+    });
+}
+
+template <typename T>
+std::pair<Parse::OptionHandle<T>, Parse::ErrorCode>
+Parse::Parser::addConstraint(const std::string& group_name, const std::string& key, std::vector<T> allowed)
+{
+    return addConstraint<T>(group_name, key, [allowed = std::move(allowed)](const T& value)
+    {
+        return std::find(allowed.begin(), allowed.end(), value) != allowed.end();
+    });
+}
+
+template <typename T>
+const T& Parse::Parser::validatedOption(OptionHandle<T> handle) const
+{
+    assert(handle._index < _constraints.size());
+    return *static_cast<const T*>(_constraints[handle._index].value.get());
+}
+
 template<>
 class Parse::Convert<std::string>
 {
@@ -326,7 +687,17 @@ class Parse::Convert<std::chrono::duration<Rep, RatioT>>
 public:
     std::pair<std::chrono::duration<Rep, RatioT>, ErrorCode> operator()(const std::string &str) const
     {
-        return {timeConversion::TimeConverter::stringToTime<std::chrono::duration<Rep, RatioT>>(str), Success};
+        return timeConversion::TimeConverter::tryStringToTime<std::chrono::duration<Rep, RatioT>>(str);
+    }
+};
+
+template <typename Table, typename Rep>
+class Parse::Convert<unitConversion::Quantity<Table, Rep>>
+{
+public:
+    std::pair<unitConversion::Quantity<Table, Rep>, ErrorCode> operator()(const std::string &str) const
+    {
+        return unitConversion::tryStringToQuantity<unitConversion::Quantity<Table, Rep>>(str);
     }
 };
 
@@ -337,4 +708,178 @@ public:
     std::pair<char, ErrorCode> operator()(const std::string &str) const;
 };
 
+namespace Parse
+{
+    /*!
+     * Converts single element of fixed-size aggregate
+     * @tparam T Type of the element
+     * @param value Element to store converted value to
+     * @param str String to be converted
+     * @param error Conversion error code
+     * @return true if converted successfully, false otherwise
+     */
+    template <typename T>
+    bool convertElement(T& value, const std::string& str, ErrorCode& error)
+    {
+        auto res = Convert<T>()(str);
+        error = res.second;
+        if(error != Success)
+            return false;
+        value = std::move(res.first);
+        return true;
+    }
+
+    /*!
+     * Converts strings into fixed-size aggregate element by element. Arity and element converters are resolved at
+     * compile time
+     * @tparam T Aggregate type (std::array, std::pair, std::tuple)
+     * @param strings Strings to be converted
+     * @return Tools error code and converted aggregate
+     * @retval Success
+     * @retval IncorrectFileContainment Strings count doesn't equal to aggregate size
+     * @copydetails convertErrors
+     */
+    template <typename T, size_t... I>
+    std::pair<T, ErrorCode> convertFixedSize(const std::vector<std::string>& strings, std::index_sequence<I...>)
+    {
+        static_assert(is_fixed_size_v<T>);
+        if(strings.size() != sizeof...(I))
+            return {{}, IncorrectFileContainment};
+        T res{};
+        ErrorCode error = Success;
+        if(!(convertElement(std::get<I>(res), strings[I], error) && ...))
+            return {{}, error};
+        return {std::move(res), Success};
+    }
+}
+
+template <typename T, size_t N>
+class Parse::Convert<std::array<T, N>>
+{
+public:
+    std::pair<std::array<T, N>, ErrorCode> operator()(const std::vector<std::string> &strings) const
+    {
+        return convertFixedSize<std::array<T, N>>(strings, std::make_index_sequence<N>());
+    }
+};
+
+template <typename T, typename U>
+class Parse::Convert<std::pair<T, U>>
+{
+public:
+    std::pair<std::pair<T, U>, ErrorCode> operator()(const std::vector<std::string> &strings) const
+    {
+        return convertFixedSize<std::pair<T, U>>(strings, std::make_index_sequence<2>());
+    }
+};
+
+template <typename... Ts>
+class Parse::Convert<std::tuple<Ts...>>
+{
+public:
+    std::pair<std::tuple<Ts...>, ErrorCode> operator()(const std::vector<std::string> &strings) const
+    {
+        return convertFixedSize<std::tuple<Ts...>>(strings, std::index_sequence_for<Ts...>());
+    }
+};
+
+template<>
+class Parse::ToString<std::string>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(const std::string &value) const;
+};
+
+template <>
+class Parse::ToString<float>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(float value) const;
+};
+
+template <>
+class Parse::ToString<double>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(double value) const;
+};
+
+template <>
+class Parse::ToString<int>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(int value) const;
+};
+
+template <>
+class Parse::ToString<long double>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(long double value) const;
+};
+
+template <>
+class Parse::ToString<long>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(long value) const;
+};
+
+template <>
+class Parse::ToString<long long>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(long long value) const;
+};
+
+template <>
+class Parse::ToString<unsigned long>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(unsigned long value) const;
+};
+
+template <>
+class Parse::ToString<unsigned long long>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(unsigned long long value) const;
+};
+
+template <>
+class Parse::ToString<bool>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(bool value) const;
+};
+
+template <typename Rep, typename RatioT>
+class Parse::ToString<std::chrono::duration<Rep, RatioT>>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(std::chrono::duration<Rep, RatioT> value) const
+    {
+        if(value.count() < 0)
+            return {"", OutOfRange};
+        return {timeConversion::TimeConverter::timeToString(value), Success};
+    }
+};
+
+template <typename Table, typename Rep>
+class Parse::ToString<unitConversion::Quantity<Table, Rep>>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(unitConversion::Quantity<Table, Rep> value) const
+    {
+        return ToString<unsigned long long>()(value.count());
+    }
+};
+
+template <>
+class Parse::ToString<char>
+{
+public:
+    std::pair<std::string, ErrorCode> operator()(char value) const;
+};
+
 #endif //EXPLORATIONS_PARSER_H
\ No newline at end of file
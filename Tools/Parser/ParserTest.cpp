@@ -16,6 +16,7 @@
 
 #include <TestsPreparations.h>
 #include <Parser.h>
+#include <zlib.h>
 
 #define MAX_NUM(type) std::numeric_limits<type>::max()
 #define MAX_NUM1(type) std::numeric_limits<type>::max() - 1u
@@ -62,6 +63,237 @@ TEST_CASE("ParserTest")
             remove("Parse.ini");
     }
 
+    SECTION("LoadMultipleFiles", "[Parse]")
+    {
+        std::vector<std::string> fileNames;
+        for (size_t i = 0; i < 16; ++i)
+        {
+            fileNames.emplace_back("ParseBatch" + std::to_string(i) + "TEST.ini");
+            std::fstream file(fileNames.back(), std::fstream::out | std::fstream::trunc);
+            file << "[Common]\n"
+                    "index=" + std::to_string(i) + "\n";
+        }
+        fileNames.emplace_back("ParseBatchNonExistingTEST.ini");
+
+        auto parsers = Parse::Parser::loadConfigFiles(fileNames, 4);
+        REQUIRE(parsers.size() == fileNames.size());
+        for (size_t i = 0; i + 1 < parsers.size(); ++i)
+        {
+            REQUIRE(parsers[i].second == Parse::Success);
+            REQUIRE(parsers[i].first.isOpen());
+            auto index = parsers[i].first.parseSingleOption<unsigned long>("Common", "index");
+            REQUIRE(index.second == Parse::Success);
+            REQUIRE(index.first == i);
+        }
+        REQUIRE(parsers.back().second == Parse::LoadFailed);
+        REQUIRE(!parsers.back().first.isOpen());
+        REQUIRE(Parse::Parser::loadConfigFiles({}).empty());
+
+        for (auto &fileName: fileNames)
+            remove(fileName.c_str());
+    }
+
+    SECTION("WriteFile", "[Parse]")
+    {
+        std::string fileName = "ParseWriteTEST.ini";
+        Parse::Parser config;
+        REQUIRE(config.removeKey("Common", "field1") == Parse::FileNotLoaded);
+        REQUIRE(config.toData().second == Parse::FileNotLoaded);
+        REQUIRE(config.saveConfigFile(fileName) == Parse::FileNotLoaded);
+
+        REQUIRE(config.setOption<std::string>("Common", "string", "value1\\value2;value3") == Parse::Success);
+        REQUIRE(config.isOpen());
+        REQUIRE(config.setOption("Common", "removed", 1) == Parse::Success);
+        REQUIRE(config.setOption("Common", "char", '\n') == Parse::Success);
+        REQUIRE(config.setOption("Types", "bool", true) == Parse::Success);
+        REQUIRE(config.setOption("Types", "long", MAX_NUM(long)) == Parse::Success);
+        REQUIRE(config.setOption("Types", "unsignedlonglong", MAX_NUM(unsigned long long)) == Parse::Success);
+        REQUIRE(config.setOption("Types", "double", MAX_NUM(double)) == Parse::Success);
+        REQUIRE(config.setOption("Types", "float", 1.23f) == Parse::Success);
+        REQUIRE(config.setOption("Types", "duration", std::chrono::minutes(90)) == Parse::Success);
+        REQUIRE(config.setOption("Types", "negativeDuration", std::chrono::minutes(-90)) == Parse::OutOfRange);
+        REQUIRE(config.setMultipleOptions<std::string>("Multiple", "strings", {"a;b", "c\\", ""}) == Parse::Success);
+        REQUIRE(config.setMultipleOptions<int>("Multiple", "ints", {1, -2, 3}) == Parse::Success);
+        REQUIRE(config.removeKey("Common", "removed") == Parse::Success);
+        REQUIRE(config.removeKey("Common", "removed") == Parse::KeyNotFound);
+        REQUIRE(config.removeKey("Comon", "removed") == Parse::GroupNotFound);
+        REQUIRE(config.saveConfigFile("NonExistingDirectory/" + fileName) == Parse::SaveFailed);
+        REQUIRE(config.saveConfigFile(fileName) == Parse::Success);
+        auto data = config.toData();
+        REQUIRE(data.second == Parse::Success);
+
+        Parse::Parser loaded;
+        REQUIRE(loaded.loadConfigFile(fileName) == Parse::Success);
+        REQUIRE(loaded.toData().first == data.first);
+        REQUIRE(loaded.parseSingleOption<std::string>("Common", "string").first == "value1\\value2;value3");
+        REQUIRE(loaded.parseSingleOption<int>("Common", "removed").second == Parse::KeyNotFound);
+        REQUIRE(loaded.parseSingleOption<char>("Common", "char").first == '\n');
+        REQUIRE(loaded.parseSingleOption<bool>("Types", "bool").first);
+        REQUIRE(loaded.parseSingleOption<long>("Types", "long").first == MAX_NUM(long));
+        REQUIRE(loaded.parseSingleOption<unsigned long long>("Types", "unsignedlonglong").first ==
+                MAX_NUM(unsigned long long));
+        REQUIRE(loaded.parseSingleOption<double>("Types", "double").first == MAX_NUM(double));
+        REQUIRE(loaded.parseSingleOption<float>("Types", "float").first == 1.23f);
+        REQUIRE(loaded.parseSingleOption<std::string>("Types", "duration").first == "90M");
+        REQUIRE(loaded.parseSingleOption<std::chrono::seconds>("Types", "duration").first == std::chrono::minutes(90));
+        REQUIRE(loaded.parseMultipleOptions<std::string>("Multiple", "strings").first ==
+                std::vector<std::string>{"a;b", "c\\", ""});
+        REQUIRE(loaded.parseMultipleOptions<int>("Multiple", "ints").first == std::vector<int>{1, -2, 3});
+        remove(fileName.c_str());
+    }
+
+    SECTION("LoadTimeValidation", "[Parse]")
+    {
+        std::string fileName = "ParseValidationTEST.ini";
+        Parse::Parser writer;
+        writer.setOption("Common", "threads", 8);
+        writer.setOption<std::string>("Common", "mode", "fast");
+        writer.setOption<std::string>("Common", "timeout", "2M");
+        writer.saveConfigFile(fileName);
+
+        Parse::Parser config;
+        auto threads = config.addConstraint<long>("Common", "threads", 1, 64).first;
+        auto mode = config.addConstraint<std::string>("Common", "mode", {"fast", "safe"}).first;
+        auto timeout = config.addConstraint<std::chrono::seconds>("Common", "timeout").first;
+        REQUIRE(config.validatedOption(threads) == 0);
+        REQUIRE(config.validatedOption(mode).empty());
+        REQUIRE(config.loadConfigFile(fileName) == Parse::Success);
+        REQUIRE(config.validatedOption(threads) == 8);
+        REQUIRE(config.validatedOption(mode) == "fast");
+        REQUIRE(config.validatedOption(timeout) == std::chrono::seconds(120));
+
+        writer.setOption("Common", "threads", 128);
+        writer.saveConfigFile(fileName);
+        REQUIRE(config.loadConfigFile(fileName) == Parse::ConstraintViolated);
+        REQUIRE(config.validatedOption(threads) == 8);
+        REQUIRE(config.parseSingleOption<long>("Common", "threads").first == 8);
+
+        writer.setOption<std::string>("Common", "threads", "abc");
+        writer.saveConfigFile(fileName);
+        REQUIRE(config.loadConfigFile(fileName) == Parse::IncorrectFileContainment);
+
+        writer.setOption("Common", "threads", 16);
+        writer.setOption<std::string>("Common", "mode", "slow");
+        writer.saveConfigFile(fileName);
+        REQUIRE(config.loadConfigFile(fileName) == Parse::ConstraintViolated);
+
+        writer.removeKey("Common", "mode");
+        writer.saveConfigFile(fileName);
+        REQUIRE(config.loadConfigFile(fileName) == Parse::KeyNotFound);
+
+        auto even = config.addConstraint<int>("Common", "threads", [](const int& value) { return value % 2 == 0; });
+        REQUIRE(even.second == Parse::Success);
+        REQUIRE(config.validatedOption(even.first) == 8);
+        writer.setOption<std::string>("Common", "mode", "safe");
+        writer.saveConfigFile(fileName);
+        REQUIRE(config.loadConfigFile(fileName) == Parse::Success);
+        REQUIRE(config.validatedOption(threads) == 16);
+        REQUIRE(config.validatedOption(mode) == "safe");
+        REQUIRE(config.validatedOption(even.first) == 16);
+
+        const std::string& modeReference = config.validatedOption(mode);
+        const long& threadsReference = config.validatedOption(threads);
+        std::string previousMode = modeReference;
+        writer.setOption<std::string>("Common", "mode", "fast");
+        writer.setOption("Common", "threads", 32);
+        writer.saveConfigFile(fileName);
+        std::vector<Parse::OptionHandle<long>> positive;
+        for (size_t i = 0; i < 32; ++i)
+            positive.push_back(config.addConstraint<long>("Common", "threads", 1, MAX_NUM(long)).first);
+        REQUIRE(config.loadConfigFile(fileName) == Parse::Success);
+        REQUIRE(previousMode == "safe");
+        REQUIRE(&config.validatedOption(mode) == &modeReference);
+        REQUIRE(modeReference == "fast");
+        REQUIRE(threadsReference == 32);
+        REQUIRE(config.validatedOption(positive.back()) == 32);
+
+        auto odd = config.addConstraint<int>("Common", "threads", [](const int& value) { return value % 2 != 0; });
+        REQUIRE(odd.second == Parse::ConstraintViolated);
+        REQUIRE(config.validatedOption(odd.first) == 0);
+        REQUIRE(config.loadConfigFile(fileName) == Parse::ConstraintViolated);
+        REQUIRE(modeReference == "fast");
+        remove(fileName.c_str());
+    }
+
+    SECTION("LoadCompressedFile", "[Parse]")
+    {
+        std::string fileName = "ParseCompressedTEST.ini.gz";
+        std::string content = "[Common]\n";
+        for (size_t i = 0; i < 20000; ++i)
+            content += "key" + std::to_string(i) + "=value" + std::to_string(i) + ";1H\n";
+
+        gzFile compressed = gzopen(fileName.c_str(), "wb");
+        REQUIRE(compressed != nullptr);
+        REQUIRE(gzwrite(compressed, content.data(), content.size()) == int(content.size()));
+        gzclose(compressed);
+
+        Parse::Parser config;
+        REQUIRE(config.loadConfigFile(fileName) == Parse::Success);
+        auto value = config.parseMultipleOptions<std::string>("Common", "key19999");
+        REQUIRE(value.second == Parse::Success);
+        REQUIRE(value.first == std::vector<std::string>{"value19999", "1H"});
+        REQUIRE(config.parseGroup("Common").first.size() == 20000);
+
+        std::fstream file(fileName, std::fstream::in | std::fstream::out | std::fstream::binary);
+        file.seekp(20);
+        file << "corrupted";
+        file.close();
+        REQUIRE(config.loadConfigFile(fileName) == Parse::LoadFailed);
+        REQUIRE(config.parseGroup("Common").second == Parse::Success);
+        remove(fileName.c_str());
+    }
+
+    SECTION("LoadTruncatedCompressedFile", "[Parse]")
+    {
+        std::string fileName = "ParseTruncatedTEST.ini.gz";
+        std::string content = "[Common]\n";
+        for (size_t i = 0; i < 20000; ++i)
+            content += "key" + std::to_string(i) + "=" + std::to_string(i * 7919 % 10007) + "\n";
+
+        gzFile compressed = gzopen(fileName.c_str(), "wb");
+        REQUIRE(compressed != nullptr);
+        REQUIRE(gzwrite(compressed, content.data(), content.size()) == int(content.size()));
+        gzclose(compressed);
+
+        std::ifstream input(fileName, std::ifstream::binary);
+        std::string bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+        input.close();
+        for (size_t size: {bytes.size() / 2, bytes.size() - 4})
+        {
+            INFO("Truncated to " << size << " of " << bytes.size() << " bytes");
+            std::ofstream output(fileName, std::ofstream::binary | std::ofstream::trunc);
+            output.write(bytes.data(), std::streamsize(size));
+            output.close();
+
+            Parse::Parser config;
+            REQUIRE(config.loadConfigFile(fileName) == Parse::LoadFailed);
+            REQUIRE(!config.isOpen());
+        }
+        remove(fileName.c_str());
+    }
+
+    SECTION("LoadOversizedCompressedFile", "[Parse]")
+    {
+        std::string fileName = "ParseOversizedTEST.ini.gz";
+        std::string content = "[Common]\n" + std::string(1024 * 1024, '#') + "\n";
+
+        gzFile compressed = gzopen(fileName.c_str(), "wb9");
+        REQUIRE(compressed != nullptr);
+        size_t written = 0;
+        for (; written <= Parse::Parser::maxDecompressedSize; written += content.size())
+            REQUIRE(gzwrite(compressed, content.data(), content.size()) == int(content.size()));
+        gzclose(compressed);
+
+        std::ifstream input(fileName, std::ifstream::binary | std::ifstream::ate);
+        REQUIRE(size_t(input.tellg()) < written / 100);
+        input.close();
+
+        Parse::Parser config;
+        REQUIRE(config.loadConfigFile(fileName) == Parse::LoadFailed);
+        REQUIRE(!config.isOpen());
+        remove(fileName.c_str());
+    }
+
     SECTION("ParsingFile", "[Parse]")
     {
         WHEN("File and Parse configect are created")
@@ -149,7 +381,23 @@ TEST_CASE("ParserTest")
                  "minutes=60M\n"
                  "hours=24H\n"
                  "days=7d\n"
-                 "weeks=1w";
+                 "weeks=1w\n"
+                 "inexact=1N\n"
+                 "tooLarge=99999999999999999999w\n"
+                 "multiple=1H;30M;15S;1.5M\n"
+                 "multipleIncorrect=1H;30M;1N\n"
+
+                 "[Quantities]\n"
+                 "cache=1.5Gi\n"
+                 "limit=10k/s\n"
+                 "buffers=4K;64Ki;1Mi\n"
+                 "incorrect=4X\n"
+
+                 "[FixedSize]\n"
+                 "coordinates=10;20;30\n"
+                 "range=1.5;2.5\n"
+                 "retry=10;20;5S\n"
+                 "incorrect=10;abc\n";
 
             file.close();
             INFO("Editing file content completed");
@@ -448,6 +696,56 @@ TEST_CASE("ParserTest")
                 auto singleDurationWeeks = SINGLE<timeConversion::TimeConverter::days>("TimeConversion", "weeks");
                 REQUIRE(singleDurationWeeks.second == Parse::Success);
                 REQUIRE(singleDurationWeeks.first == timeConversion::TimeConverter::days(7));
+                auto singleDurationInexact = SINGLE<std::chrono::seconds>("TimeConversion", "inexact");
+                REQUIRE(singleDurationInexact.second == Parse::IncorrectFileContainment);
+                auto singleDurationTooLarge = SINGLE<std::chrono::seconds>("TimeConversion", "tooLarge");
+                REQUIRE(singleDurationTooLarge.second == Parse::OutOfRange);
+                auto multipleDuration = MULTI<std::chrono::seconds>("TimeConversion", "multiple");
+                REQUIRE(multipleDuration.second == Parse::Success);
+                REQUIRE(multipleDuration.first == std::vector<std::chrono::seconds>{std::chrono::seconds(3600),
+                        std::chrono::seconds(1800), std::chrono::seconds(15), std::chrono::seconds(90)});
+                auto multipleDurationIncorrect = MULTI<std::chrono::seconds>("TimeConversion", "multipleIncorrect");
+                REQUIRE(multipleDurationIncorrect.second == Parse::IncorrectFileContainment);
+                REQUIRE(multipleDurationIncorrect.first.empty());
+            }
+
+            SECTION("Parse quantities")
+            {
+                auto cache = SINGLE<unitConversion::Bytes>("Quantities", "cache");
+                REQUIRE(cache.second == Parse::Success);
+                REQUIRE(cache.first == unitConversion::Bytes(3ull << 29));
+                auto limit = SINGLE<unitConversion::Rate>("Quantities", "limit");
+                REQUIRE(limit.second == Parse::Success);
+                REQUIRE(limit.first == unitConversion::Rate(10000));
+                auto buffers = MULTI<unitConversion::Bytes>("Quantities", "buffers");
+                REQUIRE(buffers.second == Parse::Success);
+                REQUIRE(buffers.first == std::vector<unitConversion::Bytes>{unitConversion::Bytes(4000),
+                        unitConversion::Bytes(65536), unitConversion::Bytes(1048576)});
+                REQUIRE(SINGLE<unitConversion::Bytes>("Quantities", "incorrect").second ==
+                        Parse::IncorrectFileContainment);
+                REQUIRE(SINGLE<unitConversion::Quantity<unitConversion::ByteUnits, uint16_t>>("Quantities",
+                        "cache").second == Parse::OutOfRange);
+            }
+
+            SECTION("Parse fixed-size aggregates")
+            {
+                auto coordinates = MULTI<std::array<long, 3>>("FixedSize", "coordinates");
+                REQUIRE(coordinates.second == Parse::Success);
+                REQUIRE(std::is_same_v<decltype(coordinates.first), std::array<long, 3>>);
+                REQUIRE(coordinates.first == std::array<long, 3>{10, 20, 30});
+                auto range = MULTI<std::pair<float, double>>("FixedSize", "range");
+                REQUIRE(range.second == Parse::Success);
+                REQUIRE(range.first == std::pair<float, double>(1.5f, 2.5));
+                auto retry = MULTI<std::tuple<int, std::string, std::chrono::seconds>>("FixedSize", "retry");
+                REQUIRE(retry.second == Parse::Success);
+                REQUIRE(retry.first == std::make_tuple(10, std::string("20"), std::chrono::seconds(5)));
+
+                REQUIRE(MULTI<std::array<long, 2>>("FixedSize", "coordinates").second ==
+                        Parse::IncorrectFileContainment);
+                REQUIRE(MULTI<std::array<long, 4>>("FixedSize", "coordinates").second ==
+                        Parse::IncorrectFileContainment);
+                REQUIRE(MULTI<std::pair<int, int>>("FixedSize", "incorrect").second == Parse::IncorrectFileContainment);
+                REQUIRE(MULTI<std::pair<int, int>>("FixedSize", "missing").second == Parse::KeyNotFound);
             }
 
             config.close();
@@ -19,8 +19,13 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
+#include <numeric>
+#include <iterator>
+#include <cstring>
+#include <tuple>
 #include <stdexcept>
-#include <utils.h>
+#include <UnitConversion.h>
 
 namespace timeConversion
 {
@@ -30,28 +35,15 @@ namespace timeConversion
      */
     class TimeConverter
     {
-        /*!
-         * Check for division without remainder
-         */
-        template<typename T, typename U>
-        static bool checkTimeDivision(T *numerator, U denominator)
-        {
-            static_assert(std::is_integral_v <T> && std::is_integral_v <U> , "Types must be integral");
-            static_assert(std::is_unsigned_v <T> && std::is_unsigned_v <U> , "Types must be unsigned");
-            assert(numerator != nullptr);
-            assert(denominator > 0);
-
-            if (denominator == 1)
-                return true;
-            if (*numerator % denominator != 0)
-                return false;
-            *numerator = T(*numerator / denominator);
-            return true;
-        }
+        typedef unitConversion::UnitFactor UnitFactor;
 
 
+        /*!
+         * Get factor converting FromT units to ToT units
+         * @param suffix Suffix of FromT unit
+         */
         template<typename FromT, typename ToT>
-        static void convert(size_t& size, const std::string& sizeString)
+        static constexpr UnitFactor unitFactor(std::string_view suffix) noexcept
         {
             static_assert(is_duration_v <FromT> && is_duration_v <ToT> , "Types must be durations");
             static_assert(FromT::period::num > 0 && FromT::period::den > 0 &&
@@ -63,12 +55,109 @@ namespace timeConversion
 
             constexpr uint64_t diff1 = FromT::period::num * ToT::period::den;
             constexpr uint64_t diff2 = FromT::period::den * ToT::period::num;
-            if(!Utils::checkMultiplyOverflow(&size, diff1))
-                throw std::overflow_error("Size " + sizeString + " is too large");
-            if(!checkTimeDivision(&size, diff2))
-                throw std::runtime_error("Cannot divide without remainder: " + sizeString);
+            constexpr uint64_t gcd = std::gcd(diff1, diff2);
+            return {suffix, diff1 / gcd, diff2 / gcd};
+        }
+
+
+        /*!
+         * Units table for ToT type (see unitConversion::UnitConverter)
+         */
+        template<typename ToT>
+        struct Units
+        {
+            /*!
+             * Longer suffixes go first, so they are matched before their prefixes
+             */
+            static constexpr UnitFactor units[] = {
+                    unitFactor<std::chrono::milliseconds, ToT>("ms"),
+                    unitFactor<std::chrono::microseconds, ToT>("us"),
+                    unitFactor<std::chrono::nanoseconds, ToT>("ns"),
+                    unitFactor<std::chrono::duration<int64_t, std::ratio<604800>>, ToT>("w"),
+                    unitFactor<std::chrono::duration<int64_t, std::ratio<86400>>, ToT>("d"),
+                    unitFactor<std::chrono::hours, ToT>("H"),
+                    unitFactor<std::chrono::minutes, ToT>("M"),
+                    unitFactor<std::chrono::seconds, ToT>("S"),
+                    unitFactor<std::chrono::nanoseconds, ToT>("N")
+            };
+
+            /*!
+             * Seconds. Used if the only number in string has no suffix
+             */
+            static constexpr UnitFactor defaultUnit = unitFactor<std::chrono::seconds, ToT>("S");
+
+            /*!
+             * Single number with unknown suffix ("30s", "10sec") is read as seconds, as durations always were
+             */
+            static constexpr bool ignoreUnknownSuffix = true;
+        };
+
+        template<typename ToT>
+        using Engine = unitConversion::UnitConverter<Units<ToT>>;
+
+        /*!
+         * Indexes of units in units table from the largest to the smallest. Used to format durations
+         */
+        static constexpr size_t formatOrder[] = {3, 4, 5, 6, 7, 0, 1, 2};
+
+        /*!
+         * Maximal ticks count of duration with integral representation
+         */
+        template<typename T>
+        static constexpr uint64_t maxTicks = uint64_t(std::numeric_limits<typename T::rep>::max());
+
+        /*!
+         * Whether one of units equals tick of T, so any ticks count can be written with it
+         */
+        template<typename T>
+        static constexpr bool hasTickUnit() noexcept
+        {
+            for (const UnitFactor &unit: Units<T>::units)
+                if (unit.multiplier == 1 && unit.divisor == 1)
+                    return true;
+            return false;
         }
 
+        /*!
+         * Count of second fraction digits if tick of T is 10^-n seconds (n <= 9), 0 otherwise
+         */
+        template<typename T>
+        static constexpr unsigned secondFractionDigits() noexcept
+        {
+            if (T::period::num != 1)
+                return 0;
+            unsigned digits = 0;
+            intmax_t den = T::period::den;
+            for (; den % 10 == 0; den /= 10)
+                ++digits;
+            return den == 1 && digits <= 9 ? digits : 0;
+        }
+
+        /*!
+         * Convert string to duration with floating point representation: exactly via nanoseconds, or via ticks of T
+         * rounded to nearest if nanoseconds don't fit 64 bits. Fraction below nanosecond is rounded
+         */
+        template<typename T, typename Policy>
+        static constexpr std::pair<T, Parse::ErrorCode> tryStringToFloatingTime(std::string_view sizeString) noexcept
+        {
+            typedef typename T::rep rep;
+            typedef unitConversion::ConversionPolicy<false, unitConversion::Rounding::Nearest> NanosecondsPolicy;
+            typedef unitConversion::ConversionPolicy<Policy::saturate, unitConversion::Rounding::Nearest> TicksPolicy;
+
+            auto nanoseconds = Engine<std::chrono::nanoseconds>::template tryStringToValue<NanosecondsPolicy>(
+                    sizeString, std::numeric_limits<uint64_t>::max());
+            if (nanoseconds.second == Parse::Success)
+                return {std::chrono::duration_cast<T>(std::chrono::duration<rep, std::nano>(rep(nanoseconds.first))),
+                        Parse::Success};
+            if (nanoseconds.second != Parse::OutOfRange)
+                return {T(), nanoseconds.second};
+
+            auto ticks = Engine<T>::template tryStringToValue<TicksPolicy>(sizeString,
+                                                                          std::numeric_limits<uint64_t>::max());
+            return {ticks.second == Parse::Success ? T(rep(ticks.first)) : T(), ticks.second};
+        }
+
+    public:
         template<typename _Tp>
         struct is_duration : std::false_type { };
 
@@ -78,7 +167,6 @@ namespace timeConversion
         template<typename T>
         inline static const bool is_duration_v = is_duration<T>::value;
 
-    public:
         typedef std::chrono::nanoseconds  nanoseconds;
         typedef std::chrono::microseconds microseconds;
         typedef std::chrono::milliseconds milliseconds;
@@ -88,70 +176,232 @@ namespace timeConversion
         typedef std::chrono::duration <int64_t, std::ratio<86400>>  days;
         typedef std::chrono::duration <int64_t, std::ratio<604800>> weeks;
 
+        typedef unitConversion::Strict       Strict;
+        typedef unitConversion::Saturate     Saturate;
+        typedef unitConversion::RoundDown    RoundDown;
+        typedef unitConversion::RoundUp      RoundUp;
+        typedef unitConversion::RoundNearest RoundNearest;
+
+        /*!
+         * Converts string to std::chrono::duration if possible. Doesn't throw and can be evaluated at compile time
+         * @note String is a sequence of numbers with units: w (weeks), d (days), H (hours), M (minutes), S (seconds),
+         *       ms, us, ns/N (nanoseconds), e.g. "1H30M15S", "2d12H", "250ms". Numbers may have fraction part
+         *       ("1.5S"). Single number without unit or with unknown suffix ("30s", "10sec") is treated as seconds
+         * @tparam T Type the string will be converted to (must be std::chrono::duration). Durations with floating
+         *         point representation keep fraction of their unit, only saturation of Policy applies to them
+         * @tparam Policy Conversion policy: Strict (default), Saturate, RoundDown, RoundUp or RoundNearest
+         *         (see unitConversion::ConversionPolicy)
+         * @param sizeString String to be converted
+         * @return std::chrono::duration value converted from string and Tools error code
+         * @retval Success
+         * @retval IncorrectFileContainment String has wrong format or cannot be converted without remainder (the
+         *         latter only if Policy doesn't round)
+         * @retval OutOfRange Value is too large for the type and Policy doesn't saturate
+         */
+        template<typename T, typename Policy = Strict>
+        static constexpr std::pair<T, Parse::ErrorCode> tryStringToTime(std::string_view sizeString) noexcept
+        {
+            static_assert(is_duration_v<T>, "Type must be duration");
+
+            if constexpr (std::is_floating_point_v<typename T::rep>)
+                return tryStringToFloatingTime<T, Policy>(sizeString);
+            else
+            {
+                auto res = Engine<T>::template tryStringToValue<Policy>(sizeString, maxTicks<T>);
+                return {res.second == Parse::Success ? T(res.first) : T(), res.second};
+            }
+        }
+
         /*!
          * Converts std::string to std::chrono::duration if possible
          * @note String time format must be the same as linux date format (see 'man date' for details)
          * @tparam T Type the string will be converted to (must be std::chrono::duration)
+         * @tparam Policy Conversion policy (see tryStringToTime)
          * @param sizeString String to be converted
          * @return std::chrono::duration value converted from string
+         * @throw std::overflow_error Value is too large for the type
+         * @throw std::runtime_error String doesn't contain integers or cannot be converted without remainder
          */
-        template<typename T>
+        template<typename T, typename Policy = Strict>
         static T stringToTime(const std::string &sizeString)
+        {
+            auto res = tryStringToTime<T, Policy>(sizeString);
+            if (res.second == Parse::OutOfRange)
+                throw std::overflow_error("Size " + sizeString + " is too large");
+            if (res.second != Parse::Success)
+                throw std::runtime_error("Cannot convert " + sizeString + " to time");
+            return res.first;
+        }
+
+        /*!
+         * Converts column of duration strings at once. Doesn't throw
+         * @note Strings of the most common form (digits with single unit suffix) are converted by fast path, others
+         *       by tryStringToTime
+         * @tparam T Type the strings will be converted to (must be std::chrono::duration)
+         * @tparam Policy Conversion policy (see tryStringToTime)
+         * @param sizeStrings Strings to be converted
+         * @param count Count of strings
+         * @param times Array of count elements to store converted values to
+         * @param errors Array of count elements to store Tools error codes to (see tryStringToTime)
+         * @return true if all strings were converted successfully, false otherwise
+         */
+        template<typename T, typename Policy = Strict>
+        static bool stringsToTimes(const std::string_view *sizeStrings, size_t count, T *times,
+                                   Parse::ErrorCode *errors) noexcept
+        {
+            static_assert(is_duration_v<T>, "Type must be duration");
+            bool success = true;
+            for (size_t i = 0; i < count; ++i)
+            {
+                if constexpr (std::is_floating_point_v<typename T::rep>)
+                    std::tie(times[i], errors[i]) = tryStringToTime<T, Policy>(sizeStrings[i]);
+                else
+                {
+                    uint64_t ticks = 0;
+                    if (!Engine<T>::template trySimpleStringToValue<Policy>(sizeStrings[i], ticks, errors[i],
+                                                                            maxTicks<T>))
+                        std::tie(ticks, errors[i]) = Engine<T>::template tryStringToValue<Policy>(sizeStrings[i],
+                                                                                                  maxTicks<T>);
+                    times[i] = T(ticks);
+                }
+                success &= errors[i] == Parse::Success;
+            }
+            return success;
+        }
+
+        /*!
+         * Maximal count of symbols written by formatTo: sign, 20 digits and 2 symbols of unit (or point and "S")
+         */
+        static constexpr size_t maxTimeStringSize = 23;
+
+        /*!
+         * Writes duration to buffer in format accepted by stringToTime using the largest unit which represents
+         * the duration exactly, e.g. "90M", "1500ms", "2w". If no unit fits, ticks of 10^-n seconds are written as
+         * seconds with fraction, e.g. "23058430092136939.53S". Doesn't allocate memory and doesn't write terminating null
+         * @note Negative durations are prefixed with "-" and can't be parsed back
+         * @tparam T Type of duration (must be std::chrono::duration with integral representation and tick which is
+         *         one of units or 10^-n seconds, so that any duration can be written)
+         * @param buffer Buffer of at least maxTimeStringSize symbols
+         * @param time Duration to be written
+         * @return Pointer to the symbol after the last written one
+         */
+        template<typename T>
+        static char *formatTo(char *buffer, T time) noexcept
         {
             static_assert(is_duration_v<T>, "Type must be duration");
+            static_assert(std::is_integral_v<typename T::rep>, "Duration representation must be integral");
+            static_assert(Units<T>::units[formatOrder[std::size(formatOrder) - 1]].multiplier == 1,
+                          "Duration must be representable in nanoseconds");
+            static_assert(hasTickUnit<T>() || secondFractionDigits<T>() != 0,
+                          "Duration tick must be one of units or 10^-n seconds");
 
-            char *endPtr = nullptr;
-            errno = 0;
-            auto uMax = strtoumax(sizeString.c_str(), &endPtr, 10);
-            if (uMax == 0 && sizeString.c_str() == endPtr)
-                throw std::runtime_error("Size " + sizeString + " does not contain integers");
-            if (uMax == UINTMAX_MAX && errno == ERANGE)
-                throw std::overflow_error("Size " + sizeString + " is out of range");
-            if constexpr (sizeof(uMax) > sizeof(T))
+            auto count = time.count();
+            uint64_t ticks = count < 0 ? uint64_t(0) - uint64_t(count) : uint64_t(count);
+            if (count < 0)
+                *buffer++ = '-';
+            if (ticks == 0)
+            {
+                *buffer++ = '0';
+                *buffer++ = 'S';
+                return buffer;
+            }
+            for (size_t index: formatOrder)
             {
-                if (uMax > std::numeric_limits<T>::max())
-                    throw std::overflow_error("Size " + sizeString + " is too large");
+                const UnitFactor &unit = Units<T>::units[index];
+                if (ticks % unit.multiplier != 0)
+                    continue;
+                uint64_t value = ticks / unit.multiplier;
+                if (!Utils::checkMultiplyOverflow(&value, unit.divisor))
+                    continue;
+                buffer = Utils::writeUnsigned(buffer, value);
+                for (char symbol: unit.suffix)
+                    *buffer++ = symbol;
+                return buffer;
             }
 
-            auto size = uint64_t(uMax);
-            switch (*endPtr)
+            // Only ticks of 10^-n seconds get here: integral and fraction digits together don't exceed ticks digits
+            constexpr unsigned fractionDigits = secondFractionDigits<T>();
+            uint64_t scale = 1;
+            for (unsigned i = 0; i < fractionDigits; ++i)
+                scale *= 10;
+            buffer = Utils::writeUnsigned(buffer, ticks / scale);
+            uint64_t fraction = ticks % scale;
+            if (fraction != 0)
             {
-                case 'w':
-                {
-                    convert<weeks, T>(size, sizeString);
-                    break;
-                }
-                case 'd':
-                {
-                    convert<days, T>(size, sizeString);
-                    break;
-                }
-                case 'H':
-                {
-                    convert<hours, T>(size, sizeString);
-                    break;
-                }
-                case 'M':
-                {
-                    convert<minutes, T>(size, sizeString);
-                    break;
-                }
-                case 'N':
-                {
-                    convert<nanoseconds, T>(size, sizeString);
-                    break;
-                }
-                case 'S':
-                    [[fallthrough]];
-                default:
-                {
-                    convert<seconds, T>(size, sizeString);
-                    break;
-                }
+                unsigned digits = fractionDigits;
+                for (; fraction % 10 == 0; fraction /= 10)
+                    --digits;
+                *buffer++ = '.';
+                for (unsigned i = Utils::decimalDigits(fraction); i < digits; ++i)
+                    *buffer++ = '0';
+                buffer = Utils::writeUnsigned(buffer, fraction);
             }
-            return T(size);
+            *buffer++ = 'S';
+            return buffer;
+        }
+
+        /*!
+         * Converts duration to std::string in format accepted by stringToTime (see formatTo)
+         * @tparam T Type of duration (must be std::chrono::duration with integral representation)
+         * @param time Duration to be converted
+         * @return String representation of duration
+         */
+        template<typename T>
+        static std::string timeToString(T time)
+        {
+            char buffer[maxTimeStringSize];
+            return std::string(buffer, formatTo(buffer, time));
         }
     };
+
+
+    /*!
+     * @class DurationLiteral
+     * Duration string checked and converted at compile time. Created by _dur literal
+     * @tparam Symbols Duration string in TimeConverter::tryStringToTime format
+     */
+    template<char... Symbols>
+    class DurationLiteral
+    {
+        static constexpr char _string[] = {Symbols..., '\0'};
+
+    public:
+        /*!
+         * Converts literal to std::chrono::duration. Overflow or division with remainder fail to compile
+         * @tparam T Type the literal will be converted to (must be std::chrono::duration)
+         * @return std::chrono::duration value
+         */
+        template<typename T>
+        static constexpr T as() noexcept
+        {
+            constexpr auto res = TimeConverter::tryStringToTime<T>(std::string_view(_string, sizeof...(Symbols)));
+            static_assert(res.second != Parse::OutOfRange, "Duration is too large for the type");
+            static_assert(res.second == Parse::Success || res.second == Parse::OutOfRange,
+                          "Duration has wrong format or cannot be converted without remainder");
+            return res.first;
+        }
+
+        template<typename Rep, typename Period>
+        constexpr operator std::chrono::duration<Rep, Period>() const noexcept
+        {
+            return as<std::chrono::duration<Rep, Period>>();
+        }
+    };
+
+
+    namespace literals
+    {
+        /*!
+         * Duration literal, e.g. std::chrono::seconds timeout = "1H30M"_dur;
+         * @note Uses string literal operator template (GNU extension supported by GCC and Clang)
+         * @return Literal convertible to any std::chrono::duration the string can be exactly represented in
+         */
+        template<typename CharT, CharT... Symbols>
+        constexpr DurationLiteral<Symbols...> operator""_dur() noexcept
+        {
+            return {};
+        }
+    }
 }
 
 #endif //EXPLORATIONS_TIMECONVERSION_H
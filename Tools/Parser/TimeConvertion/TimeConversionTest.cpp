@@ -19,6 +19,7 @@
 
 #define DURATION timeConversion::TimeConverter
 #define STR_TO_TIME DURATION::stringToTime
+#define TRY_STR_TO_TIME DURATION::tryStringToTime
 
 
 TEST_CASE("TimeConversionTest")
@@ -145,4 +146,210 @@ TEST_CASE("TimeConversionTest")
             REQUIRE_THROWS_AS(STR_TO_TIME<DURATION::seconds>(str + "w"), std::overflow_error);
         }
     }
-}
\ No newline at end of file
+
+    SECTION("NoThrow")
+    {
+        static_assert(TRY_STR_TO_TIME<DURATION::seconds>("1H").first == DURATION::seconds(3600));
+        static_assert(TRY_STR_TO_TIME<DURATION::seconds>("1N").second == Parse::IncorrectFileContainment);
+
+        REQUIRE(TRY_STR_TO_TIME<DURATION::milliseconds>("1S") ==
+                std::make_pair(DURATION::milliseconds(1000), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::minutes>(std::string_view(" +2H1", 4)) ==
+                std::make_pair(DURATION::minutes(120), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("1N").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("ad").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("-1S").second == Parse::IncorrectFileContainment);
+
+        std::string str = std::to_string(std::numeric_limits<uint64_t>::max());
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>(str + "0N").second == Parse::OutOfRange);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>(str + "w").second == Parse::OutOfRange);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>(str + "S").second == Parse::OutOfRange);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>(std::to_string(std::numeric_limits<int64_t>::max()) + "S") ==
+                std::make_pair(DURATION::seconds::max(), Parse::Success));
+    }
+
+    SECTION("CompoundAndFractional")
+    {
+        static_assert(TRY_STR_TO_TIME<DURATION::seconds>("1H30M15S").first == DURATION::seconds(5415));
+
+        REQUIRE(STR_TO_TIME<DURATION::seconds>("1H30M15S") == DURATION::seconds(5415));
+        REQUIRE(STR_TO_TIME<DURATION::hours>("2d12H") == DURATION::hours(60));
+        REQUIRE(STR_TO_TIME<DURATION::milliseconds>("1.5S") == DURATION::milliseconds(1500));
+        REQUIRE(STR_TO_TIME<DURATION::milliseconds>("250ms") == DURATION::milliseconds(250));
+        REQUIRE(STR_TO_TIME<DURATION::microseconds>("250us") == DURATION::microseconds(250));
+        REQUIRE(STR_TO_TIME<DURATION::nanoseconds>("250ns") == DURATION::nanoseconds(250));
+        REQUIRE(STR_TO_TIME<DURATION::microseconds>("1ms250us") == DURATION::microseconds(1250));
+        REQUIRE(STR_TO_TIME<DURATION::milliseconds>("1.50S") == DURATION::milliseconds(1500));
+        REQUIRE(STR_TO_TIME<DURATION::seconds>("0.5M") == DURATION::seconds(30));
+        REQUIRE(STR_TO_TIME<DURATION::minutes>("0.25H") == DURATION::minutes(15));
+        REQUIRE(STR_TO_TIME<DURATION::minutes>(".5H") == DURATION::minutes(30));
+        REQUIRE(STR_TO_TIME<DURATION::seconds>("1.0") == DURATION::seconds(1));
+        REQUIRE(STR_TO_TIME<DURATION::nanoseconds>("0.000000001S") == DURATION::nanoseconds(1));
+        REQUIRE(STR_TO_TIME<DURATION::seconds>(" 1M1S ") == DURATION::seconds(61));
+        REQUIRE(STR_TO_TIME<DURATION::seconds>("30s") == DURATION::seconds(30));
+        REQUIRE(STR_TO_TIME<DURATION::milliseconds>(" 10sec ") == DURATION::milliseconds(10000));
+        REQUIRE(STR_TO_TIME<DURATION::seconds>("1X") == DURATION::seconds(1));
+        REQUIRE(STR_TO_TIME<DURATION::seconds>("1X30M") == DURATION::seconds(1));
+        REQUIRE(STR_TO_TIME<DURATION::milliseconds>("1.5x") == DURATION::milliseconds(1500));
+
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("1.5S").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("1H30").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("1H30X").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("1H 30M").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>("H").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds>(".S").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds>("0.0000000001S").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds>("9223372036S1S").second == Parse::OutOfRange);
+    }
+
+    SECTION("Literals")
+    {
+        using namespace timeConversion::literals;
+        constexpr DURATION::seconds timeout = "1H30M"_dur;
+        static_assert(timeout == DURATION::seconds(5400));
+        constexpr DURATION::milliseconds delay = "1.5S"_dur;
+        static_assert(delay == DURATION::milliseconds(1500));
+        static_assert("2d"_dur.as<DURATION::hours>() == DURATION::hours(48));
+
+        DURATION::nanoseconds interval = "250us"_dur;
+        REQUIRE(interval == DURATION::nanoseconds(250000));
+        REQUIRE("1w"_dur.as<DURATION::days>() == DURATION::days(7));
+    }
+
+    SECTION("Formatting")
+    {
+        REQUIRE(DURATION::timeToString(DURATION::seconds(5400)) == "90M");
+        REQUIRE(DURATION::timeToString(DURATION::seconds(7200)) == "2H");
+        REQUIRE(DURATION::timeToString(DURATION::hours(336)) == "2w");
+        REQUIRE(DURATION::timeToString(DURATION::hours(48)) == "2d");
+        REQUIRE(DURATION::timeToString(DURATION::seconds(61)) == "61S");
+        REQUIRE(DURATION::timeToString(DURATION::milliseconds(1500)) == "1500ms");
+        REQUIRE(DURATION::timeToString(DURATION::microseconds(1001)) == "1001us");
+        REQUIRE(DURATION::timeToString(DURATION::nanoseconds(1)) == "1ns");
+        REQUIRE(DURATION::timeToString(DURATION::nanoseconds(0)) == "0S");
+        REQUIRE(DURATION::timeToString(DURATION::seconds(-60)) == "-1M");
+        REQUIRE(DURATION::timeToString(DURATION::nanoseconds::max()) == "9223372036854775807ns");
+        REQUIRE(DURATION::timeToString(DURATION::nanoseconds::min()) == "-9223372036854775808ns");
+        REQUIRE(DURATION::timeToString(DURATION::weeks::max()) == "9223372036854775807w");
+
+        char buffer[DURATION::maxTimeStringSize];
+        for (uint64_t value: {1ull, 9ull, 10ull, 99ull, 100ull, 12345ull, 999999999ull, 18446744073709ull})
+        {
+            auto time = DURATION::milliseconds(value);
+            REQUIRE(STR_TO_TIME<DURATION::milliseconds>(std::string(buffer, DURATION::formatTo(buffer, time))) == time);
+        }
+
+        typedef std::chrono::duration<int64_t, std::centi> centiseconds;
+        typedef std::chrono::duration<int64_t, std::deci> deciseconds;
+        REQUIRE(DURATION::timeToString(deciseconds(15)) == "1500ms");
+        REQUIRE(DURATION::timeToString(centiseconds((1ll << 61) + 1)) == "23058430092136939.53S");
+        REQUIRE(DURATION::timeToString(centiseconds((1ll << 61) + 38)) == "23058430092136939.9S");
+        REQUIRE(DURATION::timeToString(centiseconds(-(1ll << 61) - 3)) == "-23058430092136939.55S");
+        REQUIRE(DURATION::timeToString(deciseconds::max()) == "922337203685477580.7S");
+        for (int64_t value: {(1ll << 61) + 1, (1ll << 62) + 7, 9223372036854775801ll, 9223372036854775807ll})
+        {
+            REQUIRE(STR_TO_TIME<centiseconds>(DURATION::timeToString(centiseconds(value))) == centiseconds(value));
+            REQUIRE(STR_TO_TIME<deciseconds>(DURATION::timeToString(deciseconds(value))) == deciseconds(value));
+        }
+    }
+
+    SECTION("FloatingPointDurations")
+    {
+        typedef std::chrono::duration<double> doubleSeconds;
+        typedef std::chrono::duration<double, std::ratio<60>> doubleMinutes;
+        typedef std::chrono::duration<float, std::milli> floatMilliseconds;
+        REQUIRE(STR_TO_TIME<doubleSeconds>("90M") == doubleSeconds(5400));
+        REQUIRE(STR_TO_TIME<doubleSeconds>("1500ms") == doubleSeconds(1.5));
+        REQUIRE(STR_TO_TIME<doubleSeconds>("1.25") == doubleSeconds(1.25));
+        REQUIRE(STR_TO_TIME<doubleMinutes>("90S") == doubleMinutes(1.5));
+        REQUIRE(STR_TO_TIME<doubleMinutes>("1H30M15S") == doubleMinutes(90.25));
+        REQUIRE(STR_TO_TIME<floatMilliseconds>("250us") == floatMilliseconds(0.25f));
+        REQUIRE(STR_TO_TIME<doubleSeconds>("10000000w") == doubleSeconds(6048000000000.0));
+        static_assert(TRY_STR_TO_TIME<doubleSeconds>("2d12H").first == doubleSeconds(216000));
+        REQUIRE(TRY_STR_TO_TIME<doubleSeconds>("1H 30M").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<doubleSeconds>("99999999999999999999w").second == Parse::OutOfRange);
+        REQUIRE_THROWS_AS(STR_TO_TIME<doubleSeconds>("abc"), std::runtime_error);
+
+        std::string_view strings[] = {"90M", "1.5S", "wrong"};
+        doubleSeconds times[3];
+        Parse::ErrorCode errors[3];
+        REQUIRE(!DURATION::stringsToTimes(strings, 3, times, errors));
+        REQUIRE(times[0] == doubleSeconds(5400));
+        REQUIRE(times[1] == doubleSeconds(1.5));
+        REQUIRE(errors[1] == Parse::Success);
+        REQUIRE(errors[2] == Parse::IncorrectFileContainment);
+    }
+
+    SECTION("Policies")
+    {
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::Strict>("1N").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::Saturate>("1N").second ==
+                Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::RoundDown>("1N") ==
+                std::make_pair(DURATION::seconds(0), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::RoundUp>("1N") ==
+                std::make_pair(DURATION::seconds(1), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::RoundNearest>("1N") ==
+                std::make_pair(DURATION::seconds(0), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::minutes, DURATION::RoundNearest>("89S") ==
+                std::make_pair(DURATION::minutes(1), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::minutes, DURATION::RoundNearest>("90S") ==
+                std::make_pair(DURATION::minutes(2), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::minutes, DURATION::RoundDown>("1H119S") ==
+                std::make_pair(DURATION::minutes(61), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::RoundUp>("1.0000000000000000000000001S") ==
+                std::make_pair(DURATION::seconds(2), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::RoundDown>("1.9999999999999999999999999S") ==
+                std::make_pair(DURATION::seconds(1), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::Strict>("1.0000000000000000000000000S") ==
+                std::make_pair(DURATION::seconds(1), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::seconds, DURATION::Strict>("1.0000000000000000000000001S").second ==
+                Parse::IncorrectFileContainment);
+
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds, DURATION::Strict>("99999999w").second == Parse::OutOfRange);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds, DURATION::Saturate>("99999999w") ==
+                std::make_pair(DURATION::nanoseconds::max(), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds, DURATION::Saturate>("99999999999999999999w") ==
+                std::make_pair(DURATION::nanoseconds::max(), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds, DURATION::RoundUp>("99999999999999999999.5w1N") ==
+                std::make_pair(DURATION::nanoseconds::max(), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds, DURATION::Saturate>("200000d200000d") ==
+                std::make_pair(DURATION::nanoseconds::max(), Parse::Success));
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds, DURATION::Saturate>("99999999wX").second ==
+                Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_TIME<DURATION::nanoseconds, DURATION::RoundNearest>("").second ==
+                Parse::IncorrectFileContainment);
+
+        REQUIRE(STR_TO_TIME<DURATION::hours, DURATION::RoundUp>("1S") == DURATION::hours(1));
+        REQUIRE_THROWS_AS(STR_TO_TIME<DURATION::hours>("1S"), std::runtime_error);
+        REQUIRE(STR_TO_TIME<DURATION::nanoseconds, DURATION::Saturate>("1000000w") == DURATION::nanoseconds::max());
+
+        std::vector<std::string_view> views = {"1N", "99999999w", "1500ms"};
+        std::vector<DURATION::seconds> times(views.size());
+        std::vector<Parse::ErrorCode> errors(views.size());
+        REQUIRE(DURATION::stringsToTimes<DURATION::seconds, DURATION::RoundNearest>(views.data(), views.size(),
+                                                                                     times.data(), errors.data()));
+        REQUIRE(times == std::vector<DURATION::seconds>{DURATION::seconds(0), DURATION::seconds(60479999395200),
+                                                         DURATION::seconds(2)});
+    }
+
+    SECTION("Batch")
+    {
+        std::vector<std::string> strings = {"1", "60", "1M", "1H", "2d", "1w", "1000ms", "5000000us", "3000000000ns",
+                                            "12345678901234567S", "123456789012345678", "1234567890123456789S",
+                                            "12345678901234567890S", "1H30M", "1.5M", " 1S", "+1S", "1X", "1ms1",
+                                            "", "S", "1N", "1MS", "0000000000000000001M"};
+        std::vector<std::string_view> views(strings.begin(), strings.end());
+        std::vector<DURATION::seconds> times(strings.size());
+        std::vector<Parse::ErrorCode> errors(strings.size());
+        REQUIRE(!DURATION::stringsToTimes(views.data(), views.size(), times.data(), errors.data()));
+        for (size_t i = 0; i < strings.size(); ++i)
+        {
+            INFO(strings[i]);
+            REQUIRE(std::make_pair(times[i], errors[i]) == TRY_STR_TO_TIME<DURATION::seconds>(strings[i]));
+        }
+        REQUIRE(DURATION::stringsToTimes(views.data(), 10, times.data(), errors.data()));
+        REQUIRE(times[9] == DURATION::seconds(12345678901234567));
+    }
+}
@@ -0,0 +1,307 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef EXPLORATIONS_TIMEPOINTCONVERSION_H
+#define EXPLORATIONS_TIMEPOINTCONVERSION_H
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utils.h>
+#include <ErrorCodes.h>
+
+namespace timeConversion
+{
+    /*!
+     * @class TimePointConverter Converts ISO-8601 / RFC-3339 timestamps to std::chrono::system_clock::time_point
+     * @note Parsed string must be in format YYYY-MM-DDTHH:MM:SS[.fffffffff][Z|+HH:MM|-HH:MM]. "T" may be replaced
+     *       with "t" or space, "Z" with "z". Timestamps without time zone are treated as UTC
+     */
+    class TimePointConverter
+    {
+        /*!
+         * Load up to 8 bytes of string into little-endian word
+         */
+        static uint64_t loadWord(const char *str, size_t size) noexcept
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, str, size);
+            return word;
+        }
+
+        /*!
+         * Check that word consists of digits at digitsMask bytes and of expected symbols at other bytes
+         * @param word Word to be checked
+         * @param digitsMask 0xFF at bytes which must be digits, 0x00 at other bytes
+         * @param expected Expected symbols at non-digit bytes, 0x00 at digit bytes
+         */
+        static bool checkWord(uint64_t word, uint64_t digitsMask, uint64_t expected) noexcept
+        {
+            // Non-digit bytes are replaced with '0' and then all bytes are checked to be digits at once
+            uint64_t digits = (word & digitsMask) | (0x3030303030303030ull & ~digitsMask);
+            bool allDigits = ((digits & 0xF0F0F0F0F0F0F0F0ull) |
+                              (((digits + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+                             0x3333333333333333ull;
+            return allDigits & ((word & ~digitsMask) == expected);
+        }
+
+        static constexpr unsigned digit(const char *str, size_t pos) noexcept
+        {
+            return unsigned(str[pos] - '0');
+        }
+
+        static constexpr unsigned twoDigits(const char *str, size_t pos) noexcept
+        {
+            return digit(str, pos) * 10 + digit(str, pos + 1);
+        }
+
+        /*!
+         * Days since 1970-01-01 of the proleptic Gregorian calendar date
+         * @see http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+         */
+        static constexpr int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) noexcept
+        {
+            year -= month <= 2;
+            const int64_t era = (year >= 0 ? year : year - 399) / 400;
+            const auto yearOfEra = unsigned(year - era * 400);
+            const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + int64_t(dayOfEra) - 719468;
+        }
+
+        /*!
+         * Proleptic Gregorian calendar date of the day since 1970-01-01
+         * @see http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+         */
+        static constexpr void civilFromDays(int64_t days, int64_t &year, unsigned &month, unsigned &day) noexcept
+        {
+            days += 719468;
+            const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            const auto dayOfEra = unsigned(days - era * 146097);
+            const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            const unsigned monthShifted = (5 * dayOfYear + 2) / 153;
+            day = dayOfYear - (153 * monthShifted + 2) / 5 + 1;
+            month = monthShifted < 10 ? monthShifted + 3 : monthShifted - 9;
+            year = int64_t(yearOfEra) + era * 400 + (month <= 2);
+        }
+
+        /*!
+         * Write value zero padded to two symbols
+         */
+        static char *writeTwoDigits(char *buffer, unsigned value) noexcept
+        {
+            buffer[0] = char('0' + value / 10);
+            buffer[1] = char('0' + value % 10);
+            return buffer + 2;
+        }
+
+        static constexpr unsigned daysInMonth(unsigned year, unsigned month) noexcept
+        {
+            constexpr unsigned char days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+            bool leap = (year % 4 == 0) & ((year % 100 != 0) | (year % 400 == 0));
+            return days[month - 1] + (month == 2 && leap);
+        }
+
+    public:
+        typedef std::chrono::system_clock::time_point timePoint;
+
+        /*!
+         * Converts ISO-8601 / RFC-3339 timestamp to std::chrono::system_clock::time_point. Doesn't throw.
+         * system_clock doesn't count leap seconds, so "23:59:60" is read as "00:00:00" of the next day
+         * @param timeString String to be converted
+         * @return Time point converted from string and Tools error code
+         * @retval Success
+         * @retval IncorrectFileContainment String has wrong format or contains nonexistent date/time
+         * @retval OutOfRange Time point can't be represented by system_clock
+         */
+        static std::pair<timePoint, Parse::ErrorCode> tryStringToTimePoint(std::string_view timeString) noexcept
+        {
+            // "YYYY-MM-DDTHH:MM:SS" is 19 symbols long
+            if (timeString.size() < 19)
+                return {timePoint(), Parse::IncorrectFileContainment};
+            const char *str = timeString.data();
+            uint64_t date = loadWord(str, 8);       // "YYYY-MM-"
+            uint64_t dateTime = loadWord(str + 8, 8); // "DDTHH:MM"
+            uint64_t seconds = loadWord(str + 16, 3); // ":SS"
+            char separator = str[10];
+            dateTime = (dateTime & ~0xFF0000ull) | (uint64_t('T') << 16);
+            if (!checkWord(date, 0x00FFFF00FFFFFFFFull, 0x2D00002D00000000ull) ||
+                !checkWord(dateTime, 0xFFFF00FFFF00FFFFull, 0x00003A0000540000ull) ||
+                !checkWord(seconds, 0xFFFF00ull, 0x3Aull) ||
+                (separator != 'T' && separator != 't' && separator != ' '))
+                return {timePoint(), Parse::IncorrectFileContainment};
+
+            unsigned year = twoDigits(str, 0) * 100 + twoDigits(str, 2);
+            unsigned month = twoDigits(str, 5);
+            unsigned day = twoDigits(str, 8);
+            unsigned hour = twoDigits(str, 11);
+            unsigned minute = twoDigits(str, 14);
+            unsigned second = twoDigits(str, 17);
+            // Leap second 60 is accepted and folded into the first second of the next minute
+            bool valid = (month - 1 < 12) & (hour < 24) & (minute < 60) & (second <= 60);
+            if (!valid || day - 1 >= daysInMonth(year, month))
+                return {timePoint(), Parse::IncorrectFileContainment};
+
+            size_t pos = 19;
+            int64_t nanoseconds = 0;
+            if (pos < timeString.size() && timeString[pos] == '.')
+            {
+                size_t fractionBegin = ++pos;
+                int64_t scale = 1000000000;
+                for (; pos < timeString.size() && timeString[pos] >= '0' && timeString[pos] <= '9'; ++pos)
+                {
+                    scale /= 10;
+                    nanoseconds += digit(str, pos) * scale;
+                }
+                if (pos == fractionBegin)
+                    return {timePoint(), Parse::IncorrectFileContainment};
+            }
+
+            int64_t offset = 0;
+            if (pos < timeString.size())
+            {
+                char zone = timeString[pos];
+                if ((zone == 'Z' || zone == 'z') && pos + 1 == timeString.size())
+                    pos += 1;
+                else if ((zone == '+' || zone == '-') && pos + 6 == timeString.size() &&
+                         checkWord(loadWord(str + pos + 1, 5), 0xFFFF00FFFFull, 0x3A0000ull))
+                {
+                    unsigned offsetHours = twoDigits(str, pos + 1);
+                    unsigned offsetMinutes = twoDigits(str, pos + 4);
+                    if (offsetHours > 23 || offsetMinutes > 59)
+                        return {timePoint(), Parse::IncorrectFileContainment};
+                    offset = (int64_t(offsetHours) * 60 + offsetMinutes) * 60;
+                    if (zone == '-')
+                        offset = -offset;
+                    pos += 6;
+                }
+                if (pos != timeString.size())
+                    return {timePoint(), Parse::IncorrectFileContainment};
+            }
+
+            int64_t totalSeconds = daysFromCivil(year, month, day) * 86400 +
+                                   int64_t(hour * 3600 + minute * 60 + second) - offset;
+            using duration = timePoint::duration;
+            constexpr auto ticksPerSecond = uint64_t(duration::period::den / duration::period::num);
+            static_assert(duration::period::num == 1 && ticksPerSecond <= 1000000000);
+            int64_t ticks = 0;
+            if (__builtin_mul_overflow(totalSeconds, int64_t(ticksPerSecond), &ticks) ||
+                __builtin_add_overflow(ticks, nanoseconds / int64_t(1000000000 / ticksPerSecond), &ticks))
+                return {timePoint(), Parse::OutOfRange};
+            return {timePoint(duration(ticks)), Parse::Success};
+        }
+
+        /*!
+         * Maximal count of symbols written by formatTo: "YYYY-MM-DDTHH:MM:SS.fffffffffZ"
+         */
+        static constexpr size_t maxTimePointStringSize = 30;
+
+        /*!
+         * Writes time point to buffer in RFC-3339 format in UTC, e.g. "2019-12-31T23:59:59.25Z". Fraction is written
+         * only if it's not zero. Doesn't allocate memory and doesn't write terminating null
+         * @param buffer Buffer of at least maxTimePointStringSize symbols
+         * @param time Time point to be written. Its year must be in range [0, 9999]
+         * @return Pointer to the symbol after the last written one
+         */
+        static char *formatTo(char *buffer, timePoint time) noexcept
+        {
+            using duration = timePoint::duration;
+            static_assert(duration::period::num == 1 && 1000000000 % duration::period::den == 0);
+            int64_t ticks = time.time_since_epoch().count();
+            int64_t seconds = ticks / duration::period::den;
+            int64_t fraction = ticks % duration::period::den;
+            if (fraction < 0)
+            {
+                fraction += duration::period::den;
+                --seconds;
+            }
+            int64_t days = seconds / 86400;
+            int64_t secondOfDay = seconds % 86400;
+            if (secondOfDay < 0)
+            {
+                secondOfDay += 86400;
+                --days;
+            }
+
+            int64_t year = 0;
+            unsigned month = 0, day = 0;
+            civilFromDays(days, year, month, day);
+            assert(year >= 0 && year <= 9999);
+            buffer = writeTwoDigits(buffer, unsigned(year / 100));
+            buffer = writeTwoDigits(buffer, unsigned(year % 100));
+            *buffer++ = '-';
+            buffer = writeTwoDigits(buffer, month);
+            *buffer++ = '-';
+            buffer = writeTwoDigits(buffer, day);
+            *buffer++ = 'T';
+            buffer = writeTwoDigits(buffer, unsigned(secondOfDay / 3600));
+            *buffer++ = ':';
+            buffer = writeTwoDigits(buffer, unsigned(secondOfDay / 60 % 60));
+            *buffer++ = ':';
+            buffer = writeTwoDigits(buffer, unsigned(secondOfDay % 60));
+            if (fraction != 0)
+            {
+                auto nanoseconds = uint64_t(fraction * (1000000000 / duration::period::den));
+                unsigned digits = 9;
+                for (; nanoseconds % 10 == 0; --digits)
+                    nanoseconds /= 10;
+                *buffer++ = '.';
+                for (unsigned i = digits; i > 0; --i, nanoseconds /= 10)
+                    buffer[i - 1] = char('0' + nanoseconds % 10);
+                buffer += digits;
+            }
+            *buffer++ = 'Z';
+            return buffer;
+        }
+
+        /*!
+         * Converts time point to std::string in RFC-3339 format in UTC (see formatTo)
+         * @param time Time point to be converted
+         * @return String representation of time point
+         */
+        static std::string timePointToString(timePoint time)
+        {
+            char buffer[maxTimePointStringSize];
+            return std::string(buffer, formatTo(buffer, time));
+        }
+
+        /*!
+         * Converts array of ISO-8601 / RFC-3339 timestamps. Doesn't throw
+         * @param timeStrings Strings to be converted
+         * @param count Count of strings
+         * @param timePoints Array of count elements to store converted time points to
+         * @param errors Array of count elements to store Tools error codes to (see tryStringToTimePoint)
+         * @return true if all strings were converted successfully, false otherwise
+         */
+        static bool stringsToTimePoints(const std::string_view *timeStrings, size_t count, timePoint *timePoints,
+                                        Parse::ErrorCode *errors) noexcept
+        {
+            bool success = true;
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto res = tryStringToTimePoint(timeStrings[i]);
+                timePoints[i] = res.first;
+                errors[i] = res.second;
+                success &= res.second == Parse::Success;
+            }
+            return success;
+        }
+    };
+}
+
+#endif //EXPLORATIONS_TIMEPOINTCONVERSION_H
@@ -0,0 +1,101 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <TestsPreparations.h>
+#include <TimePointConversion.h>
+
+#define TIME_POINT timeConversion::TimePointConverter
+#define STR_TO_TIME_POINT TIME_POINT::tryStringToTimePoint
+
+using namespace std::chrono;
+
+
+TEST_CASE("TimePointConversionTest")
+{
+    SECTION("Correct timestamps")
+    {
+        REQUIRE(STR_TO_TIME_POINT("1970-01-01T00:00:00Z") == std::make_pair(TIME_POINT::timePoint(), Parse::Success));
+        REQUIRE(STR_TO_TIME_POINT("1970-01-01T00:00:00") == std::make_pair(TIME_POINT::timePoint(), Parse::Success));
+        REQUIRE(STR_TO_TIME_POINT("2019-12-31T23:59:59Z").first == TIME_POINT::timePoint(seconds(1577836799)));
+        REQUIRE(STR_TO_TIME_POINT("2020-02-29 12:00:00z").first == TIME_POINT::timePoint(seconds(1582977600)));
+        REQUIRE(STR_TO_TIME_POINT("2000-03-01t00:00:00Z").first == TIME_POINT::timePoint(seconds(951868800)));
+        REQUIRE(STR_TO_TIME_POINT("1969-12-31T23:59:59Z").first == TIME_POINT::timePoint(seconds(-1)));
+        REQUIRE(STR_TO_TIME_POINT("1900-01-01T00:00:00Z").first == TIME_POINT::timePoint(seconds(-2208988800)));
+    }
+
+    SECTION("Fractions and time zones")
+    {
+        REQUIRE(STR_TO_TIME_POINT("1970-01-01T00:00:00.5Z").first == TIME_POINT::timePoint(milliseconds(500)));
+        REQUIRE(STR_TO_TIME_POINT("1970-01-01T00:00:01.000000001Z").first ==
+                TIME_POINT::timePoint(duration_cast<TIME_POINT::timePoint::duration>(nanoseconds(1000000001))));
+        REQUIRE(STR_TO_TIME_POINT("1970-01-01T03:30:00+03:30").first == TIME_POINT::timePoint());
+        REQUIRE(STR_TO_TIME_POINT("1969-12-31T22:00:00.25-02:00").first == TIME_POINT::timePoint(milliseconds(250)));
+    }
+
+    SECTION("Leap seconds")
+    {
+        REQUIRE(STR_TO_TIME_POINT("2016-12-31T23:59:60Z") ==
+                std::make_pair(TIME_POINT::timePoint(seconds(1483228800)), Parse::Success));
+        REQUIRE(STR_TO_TIME_POINT("2016-12-31T23:59:60.5Z").first ==
+                TIME_POINT::timePoint(seconds(1483228800) + milliseconds(500)));
+        REQUIRE(STR_TO_TIME_POINT("2017-01-01T02:59:60+03:00").first == TIME_POINT::timePoint(seconds(1483228800)));
+        REQUIRE(STR_TO_TIME_POINT("2016-12-31T23:59:60Z").first == STR_TO_TIME_POINT("2017-01-01T00:00:00Z").first);
+    }
+
+    SECTION("Incorrect timestamps")
+    {
+        for (auto str: {"", "1970-01-01", "1970-01-01T00:00", "1970/01/01T00:00:00", "1970-01-01X00:00:00",
+                        "1970-01-01T00-00-00", "197a-01-01T00:00:00", "1970-13-01T00:00:00", "1970-00-01T00:00:00",
+                        "1970-01-32T00:00:00", "1970-02-29T00:00:00", "1900-02-29T00:00:00", "1970-01-00T00:00:00",
+                        "1970-01-01T24:00:00", "1970-01-01T00:60:00", "1970-01-01T00:00:61", "1970-01-01T00:00:00.",
+                        "1970-01-01T00:00:00ZZ", "1970-01-01T00:00:00+03", "1970-01-01T00:00:00+03-00",
+                        "1970-01-01T00:00:00+24:00", "1970-01-01T00:00:00 "})
+        {
+            INFO(str);
+            REQUIRE(STR_TO_TIME_POINT(str).second == Parse::IncorrectFileContainment);
+        }
+        REQUIRE(STR_TO_TIME_POINT("9999-12-31T23:59:59Z").second == Parse::OutOfRange);
+    }
+
+    SECTION("Batch")
+    {
+        std::string_view strings[] = {"1970-01-01T00:00:00Z", "1970-01-01T00:00:01Z", "incorrect"};
+        TIME_POINT::timePoint timePoints[3];
+        Parse::ErrorCode errors[3];
+        REQUIRE(!TIME_POINT::stringsToTimePoints(strings, 3, timePoints, errors));
+        REQUIRE(timePoints[1] == TIME_POINT::timePoint(seconds(1)));
+        REQUIRE(errors[0] == Parse::Success);
+        REQUIRE(errors[1] == Parse::Success);
+        REQUIRE(errors[2] == Parse::IncorrectFileContainment);
+        REQUIRE(TIME_POINT::stringsToTimePoints(strings, 2, timePoints, errors));
+    }
+
+    SECTION("Formatting")
+    {
+        REQUIRE(TIME_POINT::timePointToString(TIME_POINT::timePoint()) == "1970-01-01T00:00:00Z");
+        REQUIRE(TIME_POINT::timePointToString(TIME_POINT::timePoint(seconds(1577836799))) == "2019-12-31T23:59:59Z");
+        REQUIRE(TIME_POINT::timePointToString(TIME_POINT::timePoint(seconds(1582977600))) == "2020-02-29T12:00:00Z");
+        REQUIRE(TIME_POINT::timePointToString(TIME_POINT::timePoint(milliseconds(-750))) ==
+                "1969-12-31T23:59:59.25Z");
+        REQUIRE(TIME_POINT::timePointToString(TIME_POINT::timePoint(seconds(-2208988800))) == "1900-01-01T00:00:00Z");
+
+        auto now = system_clock::now();
+        char buffer[TIME_POINT::maxTimePointStringSize];
+        auto end = TIME_POINT::formatTo(buffer, now);
+        REQUIRE(STR_TO_TIME_POINT(std::string_view(buffer, end - buffer)) == std::make_pair(now, Parse::Success));
+    }
+}
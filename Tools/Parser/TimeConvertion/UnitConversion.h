@@ -0,0 +1,632 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef EXPLORATIONS_UNITCONVERSION_H
+#define EXPLORATIONS_UNITCONVERSION_H
+
+#include <string>
+#include <algorithm>
+#include <string_view>
+#include <numeric>
+#include <ratio>
+#include <limits>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utils.h>
+#include <ErrorCodes.h>
+
+namespace unitConversion
+{
+    /*!
+     * @struct UnitFactor
+     * Unit suffix with multiplier and divisor converting value in this unit to ticks of target type
+     */
+    struct UnitFactor
+    {
+        std::string_view suffix;
+        uint64_t multiplier;
+        uint64_t divisor;
+    };
+
+
+    /*!
+     * Rounding of values which can't be represented in target ticks exactly
+     */
+    enum class Rounding
+    {
+        Exact,      ///< Conversion fails with IncorrectFileContainment
+        Down,       ///< Rounded toward zero
+        Up,         ///< Rounded away from zero
+        Nearest     ///< Rounded to the nearest, halves away from zero
+    };
+
+
+    /*!
+     * @struct ConversionPolicy
+     * Compile-time conversion mode
+     * @tparam SaturateV Clamp out-of-range values to maximal value instead of failing with OutOfRange
+     * @tparam RoundingV Rounding of inexact values
+     */
+    template<bool SaturateV, Rounding RoundingV>
+    struct ConversionPolicy
+    {
+        static constexpr bool saturate = SaturateV;
+        static constexpr Rounding rounding = RoundingV;
+    };
+
+    typedef ConversionPolicy<false, Rounding::Exact>   Strict;
+    typedef ConversionPolicy<true,  Rounding::Exact>   Saturate;
+    typedef ConversionPolicy<true,  Rounding::Down>    RoundDown;
+    typedef ConversionPolicy<true,  Rounding::Up>      RoundUp;
+    typedef ConversionPolicy<true,  Rounding::Nearest> RoundNearest;
+
+
+    /*!
+     * Get factor of unit which is Ratio of base unit, reduced by gcd
+     * @param suffix Suffix of the unit
+     */
+    template<typename Ratio>
+    constexpr UnitFactor ratioFactor(std::string_view suffix) noexcept
+    {
+        static_assert(Ratio::num > 0 && Ratio::den > 0, "Ratio must be positive");
+        return {suffix, uint64_t(Ratio::num), uint64_t(Ratio::den)};
+    }
+
+
+    /*!
+     * @class UnitConverter Converts strings with unit suffixes to count of target ticks
+     * @tparam Table Units table. Must contain:
+     *         static constexpr UnitFactor units[] - units, longer suffixes go before their prefixes;
+     *         static constexpr UnitFactor defaultUnit - unit used if the only number in string has no suffix.
+     *         May contain static constexpr UnitFactor perUnits[] - units of denominator written after '/'
+     *         (e.g. "10k/s"). Denominator is applied inversely and is allowed only for single number strings.
+     *         May contain static constexpr bool ignoreUnknownSuffix - if true, unknown suffix of single number is
+     *         skipped up to the end of string or space and the number is read in defaultUnit
+     */
+    template<typename Table>
+    class UnitConverter
+    {
+        template<typename T, typename = void>
+        struct has_per_units : std::false_type { };
+
+        template<typename T>
+        struct has_per_units<T, std::void_t<decltype(T::perUnits)>> : std::true_type { };
+
+        template<typename T, typename = void>
+        struct ignores_unknown_suffix : std::false_type { };
+
+        template<typename T>
+        struct ignores_unknown_suffix<T, std::void_t<decltype(T::ignoreUnknownSuffix)>>
+                : std::bool_constant<T::ignoreUnknownSuffix> { };
+
+    public:
+        /*!
+         * Convert size scaled by 10^scale to target ticks
+         * @tparam Policy Conversion policy (see ConversionPolicy)
+         * @param size Value to be converted. Contains result on success
+         * @param scale Count of fraction digits in size
+         * @param sticky Non-zero digits were dropped after the last fraction digit of size
+         * @param factor Factor of value unit
+         * @retval Success
+         * @retval OutOfRange Size is too large and Policy doesn't saturate
+         * @retval IncorrectFileContainment Cannot divide without remainder and Policy rounding is Exact
+         */
+        template<typename Policy = Strict>
+        static constexpr Parse::ErrorCode convert(uint64_t& size, unsigned scale, bool sticky,
+                                                  const UnitFactor& factor) noexcept
+        {
+            typedef unsigned __int128 uint128;
+            constexpr uint128 maxScalable = ~uint128(0) / 10;
+
+            uint128 numerator = uint128(size) * factor.multiplier;
+            uint128 denominator = factor.divisor;
+            for (; scale > 0; --scale)
+            {
+                bool scalable = denominator <= maxScalable;
+                sticky |= !scalable && numerator % 10 != 0;
+                denominator *= scalable ? 10u : 1u;
+                numerator /= scalable ? 1u : 10u;
+            }
+
+            uint128 quotient = numerator / denominator;
+            uint128 remainder = numerator % denominator;
+            bool inexact = remainder != 0 || sticky;
+            if constexpr (Policy::rounding == Rounding::Up)
+                quotient += inexact;
+            else if constexpr (Policy::rounding == Rounding::Nearest)
+                quotient += remainder != 0 && remainder >= denominator - remainder;
+
+            bool overflow = quotient > UINT64_MAX;
+            if constexpr (!Policy::saturate)
+            {
+                if (overflow)
+                    return Parse::OutOfRange;
+            }
+            if constexpr (Policy::rounding == Rounding::Exact)
+            {
+                if (inexact && !overflow)
+                    return Parse::IncorrectFileContainment;
+            }
+            size = overflow ? UINT64_MAX : uint64_t(quotient);
+            return Parse::Success;
+        }
+
+        static constexpr bool isSpace(char symbol) noexcept
+        {
+            return symbol == ' ' || (symbol >= '\t' && symbol <= '\r');
+        }
+
+        static constexpr bool isDigit(char symbol) noexcept
+        {
+            return symbol >= '0' && symbol <= '9';
+        }
+
+        /*!
+         * Append digits to value. Digits which don't fit are dropped
+         * @param str String to get digits from
+         * @param pos Position of the first digit. Position after the last digit on return
+         * @param value Value to append digits to
+         * @param digits Count of appended digits
+         * @param dropped Count of dropped digits
+         * @param sticky Set if any of dropped digits is not zero
+         */
+        static constexpr void parseDigits(std::string_view str, size_t& pos, uint64_t& value, unsigned& digits,
+                                          unsigned& dropped, bool& sticky) noexcept
+        {
+            for (digits = 0, dropped = 0; pos < str.size() && isDigit(str[pos]); ++pos)
+            {
+                auto digit = uint64_t(str[pos] - '0');
+                if (dropped == 0 && value <= (UINT64_MAX - digit) / 10)
+                {
+                    value = value * 10 + digit;
+                    ++digits;
+                }
+                else
+                {
+                    ++dropped;
+                    sticky |= digit != 0;
+                }
+            }
+        }
+
+        /*!
+         * Parse exactly 8 digits at once
+         * @param str Pointer to 8 symbols
+         * @param value Parsed value
+         * @return true if all 8 symbols are digits, false otherwise
+         */
+        static bool parseEightDigits(const char *str, uint64_t &value) noexcept
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, str, sizeof(word));
+            if ((((word & 0xF0F0F0F0F0F0F0F0ull) | (((word + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) !=
+                 0x3333333333333333ull))
+                return false;
+            word = ((word & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+            word = ((word & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+            value = ((word & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+            return true;
+        }
+
+        /*!
+         * Converts string to count of target ticks if possible. Doesn't throw and can be evaluated at compile time
+         * @note String is a sequence of numbers with units from Table, e.g. "1H30M15S". Numbers may have fraction
+         *       part ("1.5Ti"). Single number without unit (or with unknown suffix if Table::ignoreUnknownSuffix)
+         *       is treated as Table::defaultUnit. If Table has perUnits,
+         *       single number may be followed by '/' and denominator unit ("10k/s")
+         *       Integer part of every number must fit into uint64_t, otherwise value is out of range
+         * @tparam Policy Conversion policy (see ConversionPolicy)
+         * @param sizeString String to be converted
+         * @param maxValue Maximal allowed result
+         * @return Count of target ticks converted from string and Tools error code
+         * @retval Success
+         * @retval IncorrectFileContainment String has wrong format or cannot be converted without remainder (the
+         *         latter only if Policy rounding is Exact)
+         * @retval OutOfRange Value is greater than maxValue and Policy doesn't saturate
+         */
+        template<typename Policy = Strict>
+        static constexpr std::pair<uint64_t, Parse::ErrorCode> tryStringToValue(std::string_view sizeString,
+                                                                                uint64_t maxValue = UINT64_MAX) noexcept
+        {
+            size_t pos = 0;
+            while (pos < sizeString.size() && isSpace(sizeString[pos]))
+                ++pos;
+            if (pos < sizeString.size() && sizeString[pos] == '+')
+                ++pos;
+
+            uint64_t total = 0;
+            size_t components = 0;
+            while (pos < sizeString.size() && !isSpace(sizeString[pos]))
+            {
+                uint64_t size = 0;
+                unsigned integerDigits = 0, integerDropped = 0, fractionDigits = 0, fractionDropped = 0;
+                bool sticky = false;
+                parseDigits(sizeString, pos, size, integerDigits, integerDropped, sticky);
+                bool overflow = integerDropped != 0;
+                if constexpr (!Policy::saturate)
+                {
+                    if (overflow)
+                        return {0, Parse::OutOfRange};
+                }
+                if (pos < sizeString.size() && sizeString[pos] == '.')
+                {
+                    ++pos;
+                    uint64_t fraction = overflow ? UINT64_MAX : size;
+                    parseDigits(sizeString, pos, fraction, fractionDigits, fractionDropped, sticky);
+                    size = overflow ? size : fraction;
+                    fractionDigits = overflow ? 0 : fractionDigits;
+                }
+                if (integerDigits + integerDropped + fractionDigits + fractionDropped == 0)
+                    return {0, Parse::IncorrectFileContainment};
+                unsigned scale = fractionDigits;
+                for (; scale > 0 && size % 10 == 0; --scale)
+                    size /= 10;
+
+                UnitFactor factor = {};
+                if (!matchUnit(sizeString, pos, Table::units, factor))
+                {
+                    if constexpr (ignores_unknown_suffix<Table>::value)
+                    {
+                        while (components == 0 && pos < sizeString.size() && !isSpace(sizeString[pos]))
+                            ++pos;
+                    }
+                    if (components != 0 || (pos < sizeString.size() && !isSpace(sizeString[pos]) &&
+                                            !(has_per_units<Table>::value && sizeString[pos] == '/')))
+                        return {0, Parse::IncorrectFileContainment};
+                    factor = Table::defaultUnit;
+                }
+                if constexpr (has_per_units<Table>::value)
+                {
+                    if (pos < sizeString.size() && sizeString[pos] == '/')
+                    {
+                        UnitFactor perFactor = {};
+                        if (components != 0 || !matchUnit(sizeString, ++pos, Table::perUnits, perFactor))
+                            return {0, Parse::IncorrectFileContainment};
+                        if (pos < sizeString.size() && !isSpace(sizeString[pos]))
+                            return {0, Parse::IncorrectFileContainment};
+                        Parse::ErrorCode error = divideFactor(factor, perFactor);
+                        if (error != Parse::Success)
+                            return {0, error};
+                    }
+                }
+
+                Parse::ErrorCode error = overflow ? Parse::Success : convert<Policy>(size, scale, sticky, factor);
+                if (error != Parse::Success)
+                    return {0, error};
+                overflow |= !Utils::checkAddOverflow(&total, size);
+                if constexpr (!Policy::saturate)
+                {
+                    if (overflow)
+                        return {0, Parse::OutOfRange};
+                }
+                total = overflow ? UINT64_MAX : total;
+                ++components;
+            }
+            while (pos < sizeString.size() && isSpace(sizeString[pos]))
+                ++pos;
+            if (components == 0 || pos != sizeString.size())
+                return {0, Parse::IncorrectFileContainment};
+            if constexpr (!Policy::saturate)
+            {
+                if (total > maxValue)
+                    return {0, Parse::OutOfRange};
+            }
+            return {std::min(total, maxValue), Parse::Success};
+        }
+
+        /*!
+         * Converts the most common form of string: up to 19 digits followed by optional unit suffix of up to
+         * 2 symbols. The suffix is classified by the last symbols, digits are parsed 8 at a time
+         * @tparam Policy Conversion policy (see ConversionPolicy)
+         * @param sizeString String to be converted
+         * @param value Converted count of target ticks
+         * @param error Tools error code (see tryStringToValue)
+         * @param maxValue Maximal allowed result
+         * @return false if string is not of simple form and must be converted by tryStringToValue, true otherwise
+         */
+        template<typename Policy = Strict>
+        static bool trySimpleStringToValue(std::string_view sizeString, uint64_t &value, Parse::ErrorCode &error,
+                                           uint64_t maxValue = UINT64_MAX) noexcept
+        {
+            size_t digits = sizeString.size();
+            UnitFactor factor = Table::defaultUnit;
+            if (digits != 0 && !isDigit(sizeString[digits - 1]))
+            {
+                bool twoSymbols = digits >= 2 && !isDigit(sizeString[digits - 2]);
+                std::string_view suffix = sizeString.substr(digits - 1 - twoSymbols);
+                const UnitFactor *found = nullptr;
+                for (auto &unit: Table::units)
+                {
+                    if (unit.suffix == suffix)
+                        found = &unit;
+                }
+                if (found == nullptr)
+                    return false;
+                factor = *found;
+                digits -= suffix.size();
+            }
+            if (digits == 0 || digits > 19)
+                return false;
+
+            uint64_t size = 0;
+            size_t pos = 0;
+            for (uint64_t eightDigits = 0; pos + 8 <= digits; pos += 8)
+            {
+                if (!parseEightDigits(sizeString.data() + pos, eightDigits))
+                    return false;
+                size = size * 100000000 + eightDigits;
+            }
+            for (; pos < digits; ++pos)
+            {
+                if (!isDigit(sizeString[pos]))
+                    return false;
+                size = size * 10 + uint64_t(sizeString[pos] - '0');
+            }
+
+            error = convert<Policy>(size, 0, false, factor);
+            if constexpr (Policy::saturate)
+                size = std::min(size, maxValue);
+            else if (error == Parse::Success && size > maxValue)
+                error = Parse::OutOfRange;
+            value = error == Parse::Success ? size : 0;
+            return true;
+        }
+
+    private:
+        /*!
+         * Find unit which suffix starts at pos
+         * @param str String to search unit in
+         * @param pos Position of suffix. Position after suffix on success
+         * @param units Units to be matched
+         * @param factor Factor of found unit
+         * @return true if unit is found, false otherwise
+         */
+        template<size_t N>
+        static constexpr bool matchUnit(std::string_view str, size_t &pos, const UnitFactor (&units)[N],
+                                        UnitFactor &factor) noexcept
+        {
+            for (auto &unit: units)
+            {
+                if (!unit.suffix.empty() && str.substr(pos, unit.suffix.size()) == unit.suffix)
+                {
+                    factor = unit;
+                    pos += unit.suffix.size();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /*!
+         * Divide factor by denominator factor
+         * @retval Success
+         * @retval OutOfRange Resulting factor is too large
+         */
+        static constexpr Parse::ErrorCode divideFactor(UnitFactor &factor, const UnitFactor &per) noexcept
+        {
+            uint64_t multiplierGcd = std::gcd(factor.multiplier, per.multiplier);
+            uint64_t divisorGcd = std::gcd(factor.divisor, per.divisor);
+            uint64_t multiplier = per.divisor / divisorGcd;
+            uint64_t divisor = per.multiplier / multiplierGcd;
+            factor.multiplier /= multiplierGcd;
+            factor.divisor /= divisorGcd;
+            if (!Utils::checkMultiplyOverflow(&factor.multiplier, multiplier) ||
+                !Utils::checkMultiplyOverflow(&factor.divisor, divisor))
+                return Parse::OutOfRange;
+            return Parse::Success;
+        }
+    };
+
+
+    /*!
+     * Decimal (SI) prefixes: k/K (10^3), M, G, T, P, E (10^18)
+     */
+#define UNIT_CONVERSION_DECIMAL_PREFIXES(SUFFIX) \
+        ratioFactor<std::kilo>("k" SUFFIX), \
+        ratioFactor<std::kilo>("K" SUFFIX), \
+        ratioFactor<std::mega>("M" SUFFIX), \
+        ratioFactor<std::giga>("G" SUFFIX), \
+        ratioFactor<std::tera>("T" SUFFIX), \
+        ratioFactor<std::peta>("P" SUFFIX), \
+        ratioFactor<std::exa>("E" SUFFIX)
+
+    /*!
+     * Binary (IEC) prefixes: Ki (2^10), Mi, Gi, Ti, Pi, Ei (2^60)
+     */
+#define UNIT_CONVERSION_BINARY_PREFIXES(SUFFIX) \
+        ratioFactor<std::ratio<1ull << 10>>("Ki" SUFFIX), \
+        ratioFactor<std::ratio<1ull << 20>>("Mi" SUFFIX), \
+        ratioFactor<std::ratio<1ull << 30>>("Gi" SUFFIX), \
+        ratioFactor<std::ratio<1ull << 40>>("Ti" SUFFIX), \
+        ratioFactor<std::ratio<1ull << 50>>("Pi" SUFFIX), \
+        ratioFactor<std::ratio<1ull << 60>>("Ei" SUFFIX)
+
+
+    /*!
+     * @struct ByteUnits
+     * Sizes in bytes: "512", "512B", "4K", "4KB" (decimal, 4000), "1.5Ti", "1.5TiB" (binary)
+     */
+    struct ByteUnits
+    {
+        static constexpr UnitFactor units[] = {
+                UNIT_CONVERSION_BINARY_PREFIXES("B"),
+                UNIT_CONVERSION_BINARY_PREFIXES(""),
+                UNIT_CONVERSION_DECIMAL_PREFIXES("B"),
+                UNIT_CONVERSION_DECIMAL_PREFIXES(""),
+                ratioFactor<std::ratio<1>>("B")
+        };
+        static constexpr UnitFactor defaultUnit = ratioFactor<std::ratio<1>>("");
+    };
+
+
+    /*!
+     * @struct CountUnits
+     * Plain counts with decimal prefixes: "250", "10k", "1.5M"
+     */
+    struct CountUnits
+    {
+        static constexpr UnitFactor units[] = {
+                UNIT_CONVERSION_DECIMAL_PREFIXES("")
+        };
+        static constexpr UnitFactor defaultUnit = ratioFactor<std::ratio<1>>("");
+    };
+
+
+    /*!
+     * @struct RateUnits
+     * Counts per Period seconds: "10k/s", "600/M", "5/ms". Rate without denominator is per Period
+     * @tparam Period Period of target rate in seconds
+     */
+    template<typename Period = std::ratio<1>>
+    struct RateUnits
+    {
+        static constexpr UnitFactor units[] = {
+                UNIT_CONVERSION_DECIMAL_PREFIXES("")
+        };
+        static constexpr UnitFactor defaultUnit = ratioFactor<std::ratio<1>>("");
+        static constexpr UnitFactor perUnits[] = {
+                ratioFactor<std::ratio_divide<std::milli, Period>>("ms"),
+                ratioFactor<std::ratio_divide<std::micro, Period>>("us"),
+                ratioFactor<std::ratio_divide<std::nano, Period>>("ns"),
+                ratioFactor<std::ratio_divide<std::ratio<60>, Period>>("min"),
+                ratioFactor<std::ratio_divide<std::ratio<1>, Period>>("s"),
+                ratioFactor<std::ratio_divide<std::ratio<1>, Period>>("S"),
+                ratioFactor<std::ratio_divide<std::ratio<60>, Period>>("M"),
+                ratioFactor<std::ratio_divide<std::ratio<3600>, Period>>("H"),
+                ratioFactor<std::ratio_divide<std::ratio<3600>, Period>>("h"),
+                ratioFactor<std::ratio_divide<std::ratio<86400>, Period>>("d"),
+                ratioFactor<std::ratio_divide<std::ratio<604800>, Period>>("w")
+        };
+    };
+
+#undef UNIT_CONVERSION_DECIMAL_PREFIXES
+#undef UNIT_CONVERSION_BINARY_PREFIXES
+
+
+    /*!
+     * @class Quantity
+     * Count of base units of Table, e.g. Quantity<ByteUnits> is count of bytes
+     * @tparam Table Units table (see UnitConverter)
+     * @tparam Rep Unsigned integral type of count
+     */
+    template<typename Table, typename Rep = uint64_t>
+    class Quantity
+    {
+        static_assert(std::is_integral_v<Rep> && std::is_unsigned_v<Rep>, "Rep must be unsigned integral");
+
+    public:
+        typedef Table table;
+        typedef Rep rep;
+
+        constexpr Quantity() noexcept = default;
+        constexpr explicit Quantity(Rep count) noexcept : _count(count) {}
+
+        constexpr Rep count() const noexcept { return _count; }
+
+        constexpr bool operator==(const Quantity &other) const noexcept { return _count == other._count; }
+        constexpr bool operator!=(const Quantity &other) const noexcept { return _count != other._count; }
+        constexpr bool operator<(const Quantity &other) const noexcept { return _count < other._count; }
+
+    private:
+        Rep _count = 0;
+    };
+
+    typedef Quantity<ByteUnits>  Bytes;
+    typedef Quantity<CountUnits> Count;
+    typedef Quantity<RateUnits<>> Rate;
+
+    template<typename T>
+    struct is_quantity : std::false_type { };
+
+    template<typename Table, typename Rep>
+    struct is_quantity<Quantity<Table, Rep>> : std::true_type { };
+
+    template<typename T>
+    inline constexpr bool is_quantity_v = is_quantity<T>::value;
+
+
+    /*!
+     * Converts string to Quantity if possible. Doesn't throw and can be evaluated at compile time
+     * @tparam T Type the string will be converted to (must be Quantity)
+     * @tparam Policy Conversion policy (see ConversionPolicy)
+     * @param sizeString String to be converted (see UnitConverter::tryStringToValue)
+     * @return Quantity value converted from string and Tools error code
+     * @retval Success
+     * @retval IncorrectFileContainment String has wrong format or cannot be converted without remainder
+     * @retval OutOfRange Value is too large for the type
+     */
+    template<typename T, typename Policy = Strict>
+    constexpr std::pair<T, Parse::ErrorCode> tryStringToQuantity(std::string_view sizeString) noexcept
+    {
+        static_assert(is_quantity_v<T>, "Type must be quantity");
+        auto res = UnitConverter<typename T::table>::template tryStringToValue<Policy>(
+                sizeString, uint64_t(std::numeric_limits<typename T::rep>::max()));
+        return {T(typename T::rep(res.first)), res.second};
+    }
+
+    /*!
+     * Converts std::string to Quantity if possible
+     * @tparam T Type the string will be converted to (must be Quantity)
+     * @tparam Policy Conversion policy (see ConversionPolicy)
+     * @param sizeString String to be converted
+     * @return Quantity value converted from string
+     * @throw std::overflow_error Value is too large for the type
+     * @throw std::runtime_error String has wrong format or cannot be converted without remainder
+     */
+    template<typename T, typename Policy = Strict>
+    T stringToQuantity(const std::string &sizeString)
+    {
+        auto res = tryStringToQuantity<T, Policy>(sizeString);
+        if (res.second == Parse::OutOfRange)
+            throw std::overflow_error("Size " + sizeString + " is too large");
+        if (res.second != Parse::Success)
+            throw std::runtime_error("Cannot convert " + sizeString + " to quantity");
+        return res.first;
+    }
+
+    /*!
+     * Converts column of quantity strings at once. Doesn't throw
+     * @tparam T Type the strings will be converted to (must be Quantity)
+     * @tparam Policy Conversion policy (see ConversionPolicy)
+     * @param sizeStrings Strings to be converted
+     * @param count Count of strings
+     * @param quantities Array of count elements to store converted values to
+     * @param errors Array of count elements to store Tools error codes to (see tryStringToQuantity)
+     * @return true if all strings were converted successfully, false otherwise
+     */
+    template<typename T, typename Policy = Strict>
+    bool stringsToQuantities(const std::string_view *sizeStrings, size_t count, T *quantities,
+                             Parse::ErrorCode *errors) noexcept
+    {
+        static_assert(is_quantity_v<T>, "Type must be quantity");
+        typedef UnitConverter<typename T::table> Converter;
+        constexpr auto maxValue = uint64_t(std::numeric_limits<typename T::rep>::max());
+        bool success = true;
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t value = 0;
+            if (!Converter::template trySimpleStringToValue<Policy>(sizeStrings[i], value, errors[i], maxValue))
+                std::tie(value, errors[i]) = Converter::template tryStringToValue<Policy>(sizeStrings[i], maxValue);
+            quantities[i] = T(typename T::rep(value));
+            success &= errors[i] == Parse::Success;
+        }
+        return success;
+    }
+}
+
+#endif //EXPLORATIONS_UNITCONVERSION_H
@@ -0,0 +1,129 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <TestsPreparations.h>
+#include <UnitConversion.h>
+
+#define UNITS unitConversion
+#define TRY_STR_TO_QUANTITY UNITS::tryStringToQuantity
+
+
+TEST_CASE("UnitConversionTest")
+{
+    SECTION("Bytes")
+    {
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("512") == std::make_pair(UNITS::Bytes(512), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("512B") == std::make_pair(UNITS::Bytes(512), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("512K") == std::make_pair(UNITS::Bytes(512000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("512k") == std::make_pair(UNITS::Bytes(512000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("512KB") == std::make_pair(UNITS::Bytes(512000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("512Ki") == std::make_pair(UNITS::Bytes(524288), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("512KiB") == std::make_pair(UNITS::Bytes(524288), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("4G") == std::make_pair(UNITS::Bytes(4000000000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("4Gi") == std::make_pair(UNITS::Bytes(4ull << 30), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("1.5Ti") == std::make_pair(UNITS::Bytes(3ull << 39), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("1Gi512Mi") ==
+                std::make_pair(UNITS::Bytes(3ull << 29), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("15Ei") == std::make_pair(UNITS::Bytes(15ull << 60), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("16Ei").second == Parse::OutOfRange);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("0.5B").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("512X").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("K").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("1K2").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("10k/s").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes>("").second == Parse::IncorrectFileContainment);
+    }
+
+    SECTION("Representation")
+    {
+        typedef UNITS::Quantity<UNITS::ByteUnits, uint32_t> Bytes32;
+        REQUIRE(TRY_STR_TO_QUANTITY<Bytes32>("4Gi").second == Parse::OutOfRange);
+        REQUIRE(TRY_STR_TO_QUANTITY<Bytes32>("4294967295") == std::make_pair(Bytes32(UINT32_MAX), Parse::Success));
+        REQUIRE(UNITS::stringToQuantity<Bytes32>("3Gi") == Bytes32(3u << 30));
+        REQUIRE_THROWS_AS(UNITS::stringToQuantity<Bytes32>("4Gi"), std::overflow_error);
+        REQUIRE_THROWS_AS(UNITS::stringToQuantity<Bytes32>("4Q"), std::runtime_error);
+    }
+
+    SECTION("Counts")
+    {
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Count>("250") == std::make_pair(UNITS::Count(250), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Count>("10k") == std::make_pair(UNITS::Count(10000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Count>("1.5M") == std::make_pair(UNITS::Count(1500000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Count>("1Ki").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Count>("1.0001k").second == Parse::IncorrectFileContainment);
+    }
+
+    SECTION("Rates")
+    {
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("100") == std::make_pair(UNITS::Rate(100), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("10k/s") == std::make_pair(UNITS::Rate(10000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("10k/S") == std::make_pair(UNITS::Rate(10000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("600/M") == std::make_pair(UNITS::Rate(10), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("600/min") == std::make_pair(UNITS::Rate(10), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("5/ms") == std::make_pair(UNITS::Rate(5000), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("3.6k/h") == std::make_pair(UNITS::Rate(1), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("1/M").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("1/").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("1/x").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("1k/s1").second == Parse::IncorrectFileContainment);
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate>("1k1/s").second == Parse::IncorrectFileContainment);
+
+        typedef UNITS::Quantity<UNITS::RateUnits<std::ratio<60>>> PerMinute;
+        REQUIRE(TRY_STR_TO_QUANTITY<PerMinute>("1/s") == std::make_pair(PerMinute(60), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<PerMinute>("1/M") == std::make_pair(PerMinute(1), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<PerMinute>("120/H") == std::make_pair(PerMinute(2), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<PerMinute>("2000000000/ns").second == Parse::OutOfRange);
+    }
+
+    SECTION("Policies")
+    {
+        typedef UNITS::Quantity<UNITS::ByteUnits, uint32_t> Bytes32;
+        REQUIRE(TRY_STR_TO_QUANTITY<Bytes32, UNITS::Saturate>("4Gi") ==
+                std::make_pair(Bytes32(UINT32_MAX), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Bytes, UNITS::RoundUp>("0.3B") ==
+                std::make_pair(UNITS::Bytes(1), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate, UNITS::RoundNearest>("100/M") ==
+                std::make_pair(UNITS::Rate(2), Parse::Success));
+        REQUIRE(TRY_STR_TO_QUANTITY<UNITS::Rate, UNITS::RoundDown>("100/M") ==
+                std::make_pair(UNITS::Rate(1), Parse::Success));
+        REQUIRE(UNITS::stringToQuantity<UNITS::Count, UNITS::RoundDown>("1.0001k") == UNITS::Count(1000));
+    }
+
+    SECTION("Constexpr")
+    {
+        constexpr auto res = TRY_STR_TO_QUANTITY<UNITS::Bytes>("64Mi");
+        static_assert(res.second == Parse::Success && res.first.count() == 64ull << 20);
+        REQUIRE(res.first == UNITS::Bytes(64ull << 20));
+    }
+
+    SECTION("Batch")
+    {
+        std::vector<std::string> strings = {"512", "512K", "512Ki", "512KiB", "4G", "1.5Ti", "1Gi512Mi", "16Ei",
+                                            "18446744073709551615", "18446744073709551616", "512X", "", "K",
+                                            " 1K", "00000000000000000001Ki"};
+        std::vector<std::string_view> views(strings.begin(), strings.end());
+        std::vector<UNITS::Bytes> sizes(strings.size());
+        std::vector<Parse::ErrorCode> errors(strings.size());
+        REQUIRE(!UNITS::stringsToQuantities(views.data(), views.size(), sizes.data(), errors.data()));
+        for (size_t i = 0; i < strings.size(); ++i)
+        {
+            INFO(strings[i]);
+            REQUIRE(std::make_pair(sizes[i], errors[i]) == TRY_STR_TO_QUANTITY<UNITS::Bytes>(strings[i]));
+        }
+        REQUIRE(UNITS::stringsToQuantities(views.data(), 7, sizes.data(), errors.data()));
+        REQUIRE(sizes[6] == UNITS::Bytes(3ull << 29));
+    }
+}
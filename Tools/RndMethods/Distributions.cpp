@@ -0,0 +1,88 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <Distributions.h>
+
+namespace
+{
+    rndMethods::NormalZiggurat makeNormalZiggurat() noexcept
+    {
+        constexpr double volume = 9.91256303526217e-3;
+        constexpr double scale = 0x1.0p63;
+        constexpr size_t last = rndMethods::NormalZiggurat::layers - 1;
+        rndMethods::NormalZiggurat ziggurat{};
+        double x = rndMethods::NormalZiggurat::tailStart;
+        double previous = x;
+        double q = volume / std::exp(-0.5 * x * x);
+
+        ziggurat.k[0] = uint64_t(x / q * scale);
+        ziggurat.k[1] = 0;
+        ziggurat.w[0] = q / scale;
+        ziggurat.w[last] = x / scale;
+        ziggurat.f[0] = 1.0;
+        ziggurat.f[last] = std::exp(-0.5 * x * x);
+        for (size_t i = last - 1; i >= 1; --i)
+        {
+            x = std::sqrt(-2.0 * std::log(volume / x + std::exp(-0.5 * x * x)));
+            ziggurat.k[i + 1] = uint64_t(x / previous * scale);
+            previous = x;
+            ziggurat.f[i] = std::exp(-0.5 * x * x);
+            ziggurat.w[i] = x / scale;
+        }
+        return ziggurat;
+    }
+
+    rndMethods::ExponentialZiggurat makeExponentialZiggurat() noexcept
+    {
+        constexpr double volume = 3.949659822581572e-3;
+        constexpr double scale = 0x1.0p56;
+        constexpr size_t last = rndMethods::ExponentialZiggurat::layers - 1;
+        rndMethods::ExponentialZiggurat ziggurat{};
+        double x = rndMethods::ExponentialZiggurat::tailStart;
+        double previous = x;
+        double q = volume / std::exp(-x);
+
+        ziggurat.k[0] = uint64_t(x / q * scale);
+        ziggurat.k[1] = 0;
+        ziggurat.w[0] = q / scale;
+        ziggurat.w[last] = x / scale;
+        ziggurat.f[0] = 1.0;
+        ziggurat.f[last] = std::exp(-x);
+        for (size_t i = last - 1; i >= 1; --i)
+        {
+            x = -std::log(volume / x + std::exp(-x));
+            ziggurat.k[i + 1] = uint64_t(x / previous * scale);
+            previous = x;
+            ziggurat.f[i] = std::exp(-x);
+            ziggurat.w[i] = x / scale;
+        }
+        return ziggurat;
+    }
+}
+
+
+const rndMethods::NormalZiggurat &rndMethods::NormalZiggurat::tables() noexcept
+{
+    static const NormalZiggurat ziggurat = makeNormalZiggurat();
+    return ziggurat;
+}
+
+const rndMethods::ExponentialZiggurat &rndMethods::ExponentialZiggurat::tables() noexcept
+{
+    static const ExponentialZiggurat ziggurat = makeExponentialZiggurat();
+    return ziggurat;
+}
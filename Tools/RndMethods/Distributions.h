@@ -0,0 +1,488 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef EXPLORATIONS_DISTRIBUTIONS_H
+#define EXPLORATIONS_DISTRIBUTIONS_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+
+namespace rndMethods
+{
+    /*!
+     * Get 64 random bits from engine. Full range 64-bit engines are used directly, full range 32-bit engines give
+     * two outputs (the first one is in high bits)
+     * @param engine Engine satisfying UniformRandomBitGenerator requirements
+     * @return Random bits
+     */
+    template<typename Engine>
+    inline uint64_t randomBits(Engine &engine)
+    {
+        if constexpr (Engine::min() == 0 && Engine::max() == std::numeric_limits<uint64_t>::max())
+            return uint64_t(engine());
+        else if constexpr (Engine::min() == 0 && Engine::max() == std::numeric_limits<uint32_t>::max())
+        {
+            uint64_t high = uint32_t(engine());
+            return (high << 32) | uint32_t(engine());
+        }
+        else
+            return std::uniform_int_distribution<uint64_t>()(engine);
+    }
+
+    /*!
+     * Convert random bits to double in [0, 1) by filling mantissa of a double in [1, 2)
+     */
+    inline double unitDouble(uint64_t bits) noexcept
+    {
+        uint64_t representation = (uint64_t(0x3FF) << 52) | (bits >> 12);
+        double result;
+        std::memcpy(&result, &representation, sizeof(result));
+        return result - 1.0;
+    }
+
+    /*!
+     * Convert random bits to float in [0, 1) by filling mantissa of a float in [1, 2)
+     */
+    inline float unitFloat(uint64_t bits) noexcept
+    {
+        auto representation = uint32_t((uint32_t(0x7F) << 23) | (bits >> 41));
+        float result;
+        std::memcpy(&result, &representation, sizeof(result));
+        return result - 1.0f;
+    }
+
+    /*!
+     * Convert random bits to double in (0, 1), suitable for logarithm
+     */
+    inline double openUnitDouble(uint64_t bits) noexcept
+    {
+        return (double(bits >> 11) + 0.5) * 0x1.0p-53;
+    }
+
+    /*!
+     * Generate value in [0, bound) by Lemire's nearly divisionless method. Division is done only when the first
+     * product falls into the biased zone, which happens with probability bound / 2^64
+     * @param engine Engine satisfying UniformRandomBitGenerator requirements
+     * @param bound Exclusive upper bound, must be positive
+     * @return Unbiased value in [0, bound)
+     */
+    template<typename Engine>
+    inline uint64_t boundedValue(Engine &engine, uint64_t bound)
+    {
+        auto product = (unsigned __int128)randomBits(engine) * bound;
+        if (uint64_t(product) < bound)
+        {
+            uint64_t threshold = -bound % bound;
+            while (uint64_t(product) < threshold)
+                product = (unsigned __int128)randomBits(engine) * bound;
+        }
+        return uint64_t(product >> 64);
+    }
+
+
+    /*!
+     * @class UniformIntDistribution
+     * Uniform integer distribution on [min, max] by Lemire's method with rejection threshold computed once in
+     * constructor, so generation never divides
+     * @tparam T Integral type up to 64 bits
+     */
+    template<typename T = uint64_t>
+    class UniformIntDistribution
+    {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(uint64_t));
+
+        T _min;
+        uint64_t _range;
+        uint64_t _threshold;
+
+    public:
+        typedef T result_type;
+
+        explicit UniformIntDistribution(T min = 0, T max = std::numeric_limits<T>::max()) noexcept :
+                _min(min), _range(uint64_t(std::make_unsigned_t<T>(max) - std::make_unsigned_t<T>(min)) + 1),
+                _threshold(_range ? -_range % _range : 0)
+        {
+        }
+
+        template<typename Engine>
+        T operator()(Engine &engine)
+        {
+            uint64_t bits = randomBits(engine);
+            if (_range == 0)
+                return T(std::make_unsigned_t<T>(_min) + std::make_unsigned_t<T>(bits));
+            auto product = (unsigned __int128)bits * _range;
+            while (uint64_t(product) < _threshold)
+                product = (unsigned __int128)randomBits(engine) * _range;
+            return T(std::make_unsigned_t<T>(_min) + std::make_unsigned_t<T>(product >> 64));
+        }
+
+        /*!
+         * Generate count values. Output is the same as of count operator() calls
+         */
+        template<typename Engine>
+        void fill(Engine &engine, T *output, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                output[i] = (*this)(engine);
+        }
+
+        T min() const noexcept { return _min; }
+
+        T max() const noexcept { return T(std::make_unsigned_t<T>(_min) + std::make_unsigned_t<T>(_range - 1)); }
+    };
+
+
+    /*!
+     * @class UniformRealDistribution
+     * Uniform floating point distribution on [min, max) built from mantissa bits, without integer to floating point
+     * conversion
+     * @tparam T float or double
+     */
+    template<typename T = double>
+    class UniformRealDistribution
+    {
+        static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>);
+
+        T _min;
+        T _length;
+
+    public:
+        typedef T result_type;
+
+        explicit UniformRealDistribution(T min = 0, T max = 1) noexcept : _min(min), _length(max - min) {}
+
+        template<typename Engine>
+        T operator()(Engine &engine)
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return _min + _length * unitFloat(randomBits(engine));
+            else
+                return _min + _length * unitDouble(randomBits(engine));
+        }
+
+        /*!
+         * Generate count values. Output is the same as of count operator() calls
+         */
+        template<typename Engine>
+        void fill(Engine &engine, T *output, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                output[i] = (*this)(engine);
+        }
+    };
+
+
+    /*!
+     * @struct NormalZiggurat
+     * Tables of 128 layers ziggurat for standard normal distribution (Marsaglia, Tsang). Layer i is accepted
+     * immediately if |x| < k[i], x is scaled to layer width by w[i], f[i] is density at layer boundary
+     */
+    struct NormalZiggurat
+    {
+        static constexpr size_t layers = 128;
+        static constexpr double tailStart = 3.442619855899;
+
+        uint64_t k[layers];
+        double w[layers];
+        double f[layers];
+
+        /*!
+         * Get tables, computed once on first use
+         */
+        static const NormalZiggurat &tables() noexcept;
+    };
+
+
+    /*!
+     * @struct ExponentialZiggurat
+     * Tables of 256 layers ziggurat for standard exponential distribution (Marsaglia, Tsang)
+     */
+    struct ExponentialZiggurat
+    {
+        static constexpr size_t layers = 256;
+        static constexpr double tailStart = 7.697117470131487;
+
+        uint64_t k[layers];
+        double w[layers];
+        double f[layers];
+
+        /*!
+         * Get tables, computed once on first use
+         */
+        static const ExponentialZiggurat &tables() noexcept;
+    };
+
+
+    /*!
+     * @class NormalDistribution
+     * Normal distribution by ziggurat method: about 99% of values take one engine word, one multiplication and one
+     * comparison
+     * @tparam T float or double
+     */
+    template<typename T = double>
+    class NormalDistribution
+    {
+        static_assert(std::is_floating_point_v<T>);
+
+        const NormalZiggurat *_ziggurat;
+        T _mean;
+        T _stddev;
+
+        template<typename Engine>
+        double standard(Engine &engine)
+        {
+            const NormalZiggurat &ziggurat = *_ziggurat;
+            while (true)
+            {
+                uint64_t bits = randomBits(engine);
+                size_t layer = bits & (NormalZiggurat::layers - 1);
+                auto value = int64_t(bits & ~uint64_t(NormalZiggurat::layers - 1));
+                uint64_t magnitude = value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value);
+                double x = double(value) * ziggurat.w[layer];
+                if (magnitude < ziggurat.k[layer])
+                    return x;
+                if (layer == 0)
+                {
+                    double tailX, tailY;
+                    do
+                    {
+                        tailX = -std::log(openUnitDouble(randomBits(engine))) / NormalZiggurat::tailStart;
+                        tailY = -std::log(openUnitDouble(randomBits(engine)));
+                    } while (tailY + tailY < tailX * tailX);
+                    return value < 0 ? -NormalZiggurat::tailStart - tailX : NormalZiggurat::tailStart + tailX;
+                }
+                double density = ziggurat.f[layer] +
+                                 unitDouble(randomBits(engine)) * (ziggurat.f[layer - 1] - ziggurat.f[layer]);
+                if (density < std::exp(-0.5 * x * x))
+                    return x;
+            }
+        }
+
+    public:
+        typedef T result_type;
+
+        explicit NormalDistribution(T mean = 0, T stddev = 1) noexcept :
+                _ziggurat(&NormalZiggurat::tables()), _mean(mean), _stddev(stddev)
+        {
+        }
+
+        template<typename Engine>
+        T operator()(Engine &engine)
+        {
+            return _mean + _stddev * T(standard(engine));
+        }
+
+        /*!
+         * Generate count values. Output is the same as of count operator() calls
+         */
+        template<typename Engine>
+        void fill(Engine &engine, T *output, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                output[i] = (*this)(engine);
+        }
+    };
+
+
+    /*!
+     * @class ExponentialDistribution
+     * Exponential distribution by ziggurat method
+     * @tparam T float or double
+     */
+    template<typename T = double>
+    class ExponentialDistribution
+    {
+        static_assert(std::is_floating_point_v<T>);
+
+        const ExponentialZiggurat *_ziggurat;
+        T _scale;
+
+        template<typename Engine>
+        double standard(Engine &engine)
+        {
+            const ExponentialZiggurat &ziggurat = *_ziggurat;
+            while (true)
+            {
+                uint64_t bits = randomBits(engine);
+                size_t layer = bits & (ExponentialZiggurat::layers - 1);
+                uint64_t value = bits >> 8;
+                double x = double(value) * ziggurat.w[layer];
+                if (value < ziggurat.k[layer])
+                    return x;
+                if (layer == 0)
+                    return ExponentialZiggurat::tailStart - std::log(openUnitDouble(randomBits(engine)));
+                double density = ziggurat.f[layer] +
+                                 unitDouble(randomBits(engine)) * (ziggurat.f[layer - 1] - ziggurat.f[layer]);
+                if (density < std::exp(-x))
+                    return x;
+            }
+        }
+
+    public:
+        typedef T result_type;
+
+        /*!
+         * @param lambda Rate, mean of distribution is 1 / lambda
+         */
+        explicit ExponentialDistribution(T lambda = 1) noexcept :
+                _ziggurat(&ExponentialZiggurat::tables()), _scale(1 / lambda)
+        {
+        }
+
+        template<typename Engine>
+        T operator()(Engine &engine)
+        {
+            return _scale * T(standard(engine));
+        }
+
+        /*!
+         * Generate count values. Output is the same as of count operator() calls
+         */
+        template<typename Engine>
+        void fill(Engine &engine, T *output, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                output[i] = (*this)(engine);
+        }
+    };
+
+
+    /*!
+     * @class ZipfDistribution
+     * Zipf distribution on [1, n]: P(k) ~ 1 / k^s. Rejection-inversion method (Hörmann, Derflinger) takes O(1)
+     * time and memory for any n and s > 0, about 1.1 engine words per value
+     * @tparam T Integral type
+     */
+    template<typename T = uint64_t>
+    class ZipfDistribution
+    {
+        static_assert(std::is_integral_v<T>);
+
+        T _count;
+        double _exponent;
+        double _integralFirst;
+        double _integralLast;
+        double _squeeze;
+
+        static double helperLog(double x) noexcept
+        {
+            return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+        }
+
+        static double helperExp(double x) noexcept
+        {
+            return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+        }
+
+        double h(double x) const noexcept
+        {
+            return std::exp(-_exponent * std::log(x));
+        }
+
+        double integral(double x) const noexcept
+        {
+            double logX = std::log(x);
+            return helperExp((1 - _exponent) * logX) * logX;
+        }
+
+        double integralInverse(double x) const noexcept
+        {
+            double t = std::max(x * (1 - _exponent), -1.0);
+            return std::exp(helperLog(t) * x);
+        }
+
+    public:
+        typedef T result_type;
+
+        /*!
+         * @param count Count of elements n, must be positive
+         * @param exponent Exponent s, must be positive
+         */
+        explicit ZipfDistribution(T count, double exponent = 1) noexcept :
+                _count(count), _exponent(exponent), _integralFirst(integral(1.5) - 1),
+                _integralLast(integral(double(count) + 0.5)), _squeeze(2 - integralInverse(integral(2.5) - h(2)))
+        {
+        }
+
+        template<typename Engine>
+        T operator()(Engine &engine)
+        {
+            while (true)
+            {
+                double u = _integralLast + unitDouble(randomBits(engine)) * (_integralFirst - _integralLast);
+                double x = integralInverse(u);
+                double rounded = std::floor(x + 0.5);
+                T k = rounded < 1 ? T(1) : rounded >= double(_count) ? _count : T(rounded);
+                if (double(k) - x <= _squeeze || u >= integral(double(k) + 0.5) - h(double(k)))
+                    return k;
+            }
+        }
+
+        /*!
+         * Generate count values. Output is the same as of count operator() calls
+         */
+        template<typename Engine>
+        void fill(Engine &engine, T *output, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                output[i] = (*this)(engine);
+        }
+    };
+
+
+    /*!
+     * @class BernoulliDistribution
+     * Bernoulli distribution: true with probability p. One engine word and one integer comparison per value
+     */
+    class BernoulliDistribution
+    {
+        uint64_t _threshold;
+        bool _always;
+
+    public:
+        typedef bool result_type;
+
+        explicit BernoulliDistribution(double p = 0.5) noexcept :
+                _threshold(p <= 0 || p >= 1 ? 0 : uint64_t(p * 0x1.0p64)), _always(p >= 1)
+        {
+        }
+
+        template<typename Engine>
+        bool operator()(Engine &engine)
+        {
+            return randomBits(engine) < _threshold || _always;
+        }
+
+        /*!
+         * Generate count values. Output is the same as of count operator() calls
+         */
+        template<typename Engine>
+        void fill(Engine &engine, bool *output, size_t count)
+        {
+            for (size_t i = 0; i < count; ++i)
+                output[i] = (*this)(engine);
+        }
+    };
+}
+
+#endif //EXPLORATIONS_DISTRIBUTIONS_H
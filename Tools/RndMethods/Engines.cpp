@@ -0,0 +1,226 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <Engines.h>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ENGINES_HAS_X86_KERNELS 1
+#else
+#define ENGINES_HAS_X86_KERNELS 0
+#endif // defined(__x86_64__) || defined(__i386__)
+
+namespace
+{
+    typedef uint64_t laneState[4][rndMethods::Xoshiro256StarStarX8::lanes];
+
+    void scalarKernel(laneState &state, void *output, size_t steps)
+    {
+        auto *bytes = static_cast<uint8_t *>(output);
+        for (size_t step = 0; step < steps; ++step)
+        {
+            for (size_t lane = 0; lane < rndMethods::Xoshiro256StarStarX8::lanes; ++lane)
+            {
+                uint64_t s1 = state[1][lane];
+                uint64_t res = s1 * 5;
+                res = ((res << 7) | (res >> 57)) * 9;
+                std::memcpy(bytes + (step * rndMethods::Xoshiro256StarStarX8::lanes + lane) * sizeof(res), &res,
+                            sizeof(res));
+
+                uint64_t shifted = s1 << 17;
+                state[2][lane] ^= state[0][lane];
+                state[3][lane] ^= s1;
+                state[1][lane] ^= state[2][lane];
+                state[0][lane] ^= state[3][lane];
+                state[2][lane] ^= shifted;
+                state[3][lane] = (state[3][lane] << 45) | (state[3][lane] >> 19);
+            }
+        }
+    }
+
+#if ENGINES_HAS_X86_KERNELS
+    /*!
+     * Lanes kernel on GCC vector extensions. Compiled for target instruction set, Vector holds 4 (AVX2) or
+     * 8 (AVX-512) lanes
+     */
+    template<typename Vector>
+    inline __attribute__((always_inline)) void vectorKernel(laneState &state, void *output, size_t steps)
+    {
+        constexpr size_t width = sizeof(Vector) / sizeof(uint64_t);
+        constexpr size_t count = rndMethods::Xoshiro256StarStarX8::lanes / width;
+        auto *bytes = static_cast<uint8_t *>(output);
+        Vector s[4][count];
+        for (size_t i = 0; i < 4; ++i)
+        {
+            for (size_t part = 0; part < count; ++part)
+                std::memcpy(&s[i][part], &state[i][part * width], sizeof(Vector));
+        }
+        for (size_t step = 0; step < steps; ++step)
+        {
+            for (size_t part = 0; part < count; ++part)
+            {
+                Vector res = s[1][part] * 5;
+                res = ((res << 7) | (res >> 57)) * 9;
+                std::memcpy(bytes + (step * count + part) * sizeof(Vector), &res, sizeof(Vector));
+
+                Vector shifted = s[1][part] << 17;
+                s[2][part] ^= s[0][part];
+                s[3][part] ^= s[1][part];
+                s[1][part] ^= s[2][part];
+                s[0][part] ^= s[3][part];
+                s[2][part] ^= shifted;
+                s[3][part] = (s[3][part] << 45) | (s[3][part] >> 19);
+            }
+        }
+        for (size_t i = 0; i < 4; ++i)
+        {
+            for (size_t part = 0; part < count; ++part)
+                std::memcpy(&state[i][part * width], &s[i][part], sizeof(Vector));
+        }
+    }
+
+    typedef uint64_t vector4x64 __attribute__((vector_size(32)));
+    typedef uint64_t vector8x64 __attribute__((vector_size(64)));
+
+    __attribute__((target("avx2"))) void avx2Kernel(laneState &state, void *output, size_t steps)
+    {
+        vectorKernel<vector4x64>(state, output, steps);
+    }
+
+    __attribute__((target("avx512f"))) void avx512Kernel(laneState &state, void *output, size_t steps)
+    {
+        vectorKernel<vector8x64>(state, output, steps);
+    }
+#endif // ENGINES_HAS_X86_KERNELS
+}
+
+
+rndMethods::Xoshiro256StarStarX8::Xoshiro256StarStarX8(uint64_t seed) noexcept
+{
+    setIsa(bestIsa());
+    this->seed(seed);
+}
+
+rndMethods::Xoshiro256StarStarX8::Xoshiro256StarStarX8(const Xoshiro256StarStar &engine) noexcept
+{
+    setIsa(bestIsa());
+    seed(engine);
+}
+
+void rndMethods::Xoshiro256StarStarX8::seed(uint64_t seed) noexcept
+{
+    this->seed(Xoshiro256StarStar(seed));
+}
+
+void rndMethods::Xoshiro256StarStarX8::seed(Xoshiro256StarStar generator) noexcept
+{
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        auto state = generator.state();
+        for (size_t i = 0; i < state.size(); ++i)
+            _state[i][lane] = state[i];
+        generator.jump();
+    }
+    _position = lanes;
+}
+
+rndMethods::Xoshiro256StarStarX8::result_type rndMethods::Xoshiro256StarStarX8::operator()() noexcept
+{
+    if (_position == lanes)
+    {
+        _kernel(_state, _buffer, 1);
+        _position = 0;
+    }
+    return _buffer[_position++];
+}
+
+size_t rndMethods::Xoshiro256StarStarX8::takeBuffered(uint8_t *buffer, size_t size) noexcept
+{
+    size_t taken = 0;
+    for (; taken < size && _position < lanes; ++_position)
+    {
+        size_t count = std::min(size - taken, sizeof(result_type));
+        std::memcpy(buffer + taken, &_buffer[_position], count);
+        taken += count;
+    }
+    return taken;
+}
+
+void rndMethods::Xoshiro256StarStarX8::fill(void *buffer, size_t size) noexcept
+{
+    auto *bytes = static_cast<uint8_t *>(buffer);
+    size_t taken = takeBuffered(bytes, size);
+    bytes += taken;
+    size -= taken;
+
+    constexpr size_t stepSize = lanes * sizeof(result_type);
+    size_t steps = size / stepSize;
+    _kernel(_state, bytes, steps);
+    bytes += steps * stepSize;
+    size -= steps * stepSize;
+
+    if (size != 0)
+    {
+        _kernel(_state, _buffer, 1);
+        _position = 0;
+        takeBuffered(bytes, size);
+    }
+}
+
+rndMethods::Xoshiro256StarStarX8::Isa rndMethods::Xoshiro256StarStarX8::bestIsa() noexcept
+{
+#if ENGINES_HAS_X86_KERNELS
+    if (__builtin_cpu_supports("avx512f"))
+        return Isa::Avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return Isa::Avx2;
+#endif // ENGINES_HAS_X86_KERNELS
+    return Isa::Scalar;
+}
+
+void rndMethods::Xoshiro256StarStarX8::setIsa(Isa isa) noexcept
+{
+    _isa = std::min(isa, bestIsa());
+    _kernel = scalarKernel;
+#if ENGINES_HAS_X86_KERNELS
+    if (_isa == Isa::Avx512)
+        _kernel = avx512Kernel;
+    else if (_isa == Isa::Avx2)
+        _kernel = avx2Kernel;
+#endif // ENGINES_HAS_X86_KERNELS
+}
+
+void rndMethods::Philox4x32::fill(void *buffer, size_t size) noexcept
+{
+    auto *bytes = static_cast<uint8_t *>(buffer);
+    uint64_t words[64];
+    while (size >= sizeof(uint64_t))
+    {
+        size_t count = std::min(size / sizeof(uint64_t), std::size(words));
+        fill(_position, _position + count, words);
+        std::memcpy(bytes, words, count * sizeof(uint64_t));
+        _position += count;
+        bytes += count * sizeof(uint64_t);
+        size -= count * sizeof(uint64_t);
+    }
+    if (size)
+    {
+        uint64_t word = (*this)();
+        std::memcpy(bytes, &word, size);
+    }
+}
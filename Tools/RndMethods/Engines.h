@@ -0,0 +1,584 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef EXPLORATIONS_ENGINES_H
+#define EXPLORATIONS_ENGINES_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <array>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+
+
+namespace rndMethods
+{
+    /*!
+     * Check if engine has fill(void *buffer, size_t size) method generating random bytes in bulk
+     */
+    template<typename T, typename = void>
+    struct has_fill : std::false_type { };
+
+    template<typename T>
+    struct has_fill<T, std::void_t<decltype(std::declval<T &>().fill(std::declval<void *>(), size_t()))>> :
+            std::true_type { };
+
+
+    /*!
+     * @class SplitMix64
+     * 64-bit generator with 64 bits of state. Mostly used to expand seeds of other engines
+     * @note Satisfies UniformRandomBitGenerator requirements, so it can be used with std distributions
+     */
+    class SplitMix64
+    {
+        uint64_t _state;
+
+    public:
+        typedef uint64_t result_type;
+
+        constexpr explicit SplitMix64(uint64_t seed = 0) noexcept : _state(seed) {}
+
+        constexpr void seed(uint64_t seed) noexcept { _state = seed; }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        constexpr result_type operator()() noexcept
+        {
+            uint64_t res = (_state += 0x9E3779B97F4A7C15ull);
+            res = (res ^ (res >> 30)) * 0xBF58476D1CE4E5B9ull;
+            res = (res ^ (res >> 27)) * 0x94D049BB133111EBull;
+            return res ^ (res >> 31);
+        }
+    };
+
+
+    /*!
+     * @class Xoshiro256StarStar
+     * xoshiro256** 64-bit generator with 256 bits of state (Blackman, Vigna). Supports jumps of 2^128 and 2^192
+     * outputs ahead to get non-overlapping streams
+     */
+    class Xoshiro256StarStar
+    {
+        uint64_t _state[4];
+
+        static constexpr uint64_t rotl(uint64_t value, int shift) noexcept
+        {
+            return (value << shift) | (value >> (64 - shift));
+        }
+
+        constexpr void jump(const uint64_t (&polynomial)[4]) noexcept
+        {
+            uint64_t state[4] = {0, 0, 0, 0};
+            for (uint64_t word: polynomial)
+            {
+                for (int bit = 0; bit < 64; ++bit)
+                {
+                    if (word & (uint64_t(1) << bit))
+                    {
+                        for (int i = 0; i < 4; ++i)
+                            state[i] ^= _state[i];
+                    }
+                    (*this)();
+                }
+            }
+            for (int i = 0; i < 4; ++i)
+                _state[i] = state[i];
+        }
+
+    public:
+        typedef uint64_t result_type;
+
+        constexpr explicit Xoshiro256StarStar(uint64_t seed = 0) noexcept : _state{0, 0, 0, 0} { this->seed(seed); }
+
+        /*!
+         * Construct with given state. State must not be all zeros
+         */
+        constexpr Xoshiro256StarStar(uint64_t s0, uint64_t s1, uint64_t s2, uint64_t s3) noexcept :
+                _state{s0, s1, s2, s3} {}
+
+        /*!
+         * Seed state by SplitMix64 outputs
+         */
+        constexpr void seed(uint64_t seed) noexcept
+        {
+            SplitMix64 seeder(seed);
+            for (auto &word: _state)
+                word = seeder();
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        constexpr result_type operator()() noexcept
+        {
+            uint64_t res = rotl(_state[1] * 5, 7) * 9;
+            uint64_t shifted = _state[1] << 17;
+            _state[2] ^= _state[0];
+            _state[3] ^= _state[1];
+            _state[1] ^= _state[2];
+            _state[0] ^= _state[3];
+            _state[2] ^= shifted;
+            _state[3] = rotl(_state[3], 45);
+            return res;
+        }
+
+        /*!
+         * Advance state by 2^128 outputs
+         */
+        constexpr void jump() noexcept
+        {
+            jump({0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull});
+        }
+
+        /*!
+         * Advance state by 2^192 outputs
+         */
+        constexpr void longJump() noexcept
+        {
+            jump({0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull});
+        }
+
+        /*!
+         * Get current state
+         */
+        constexpr std::array<uint64_t, 4> state() const noexcept
+        {
+            return {_state[0], _state[1], _state[2], _state[3]};
+        }
+
+        constexpr bool operator==(const Xoshiro256StarStar &other) const noexcept
+        {
+            return _state[0] == other._state[0] && _state[1] == other._state[1] &&
+                   _state[2] == other._state[2] && _state[3] == other._state[3];
+        }
+
+        constexpr bool operator!=(const Xoshiro256StarStar &other) const noexcept { return !(*this == other); }
+    };
+
+
+    /*!
+     * @class Pcg64
+     * PCG64 (XSL RR 128/64) generator with 128-bit LCG state and selectable stream (O'Neill)
+     */
+    class Pcg64
+    {
+        typedef unsigned __int128 uint128;
+
+        static constexpr uint128 multiplier = (uint128(2549297995355413924ull) << 64) | 4865540595714422341ull;
+
+        uint128 _state = 0;
+        uint128 _increment = 1;
+
+        constexpr void bump() noexcept { _state = _state * multiplier + _increment; }
+
+    public:
+        typedef uint64_t result_type;
+
+        /*!
+         * @param seed Seed expanded by SplitMix64 to initial state and stream
+         */
+        constexpr explicit Pcg64(uint64_t seed = 0) noexcept { this->seed(seed); }
+
+        /*!
+         * @param state Initial state
+         * @param stream Stream selector
+         */
+        constexpr Pcg64(uint128 state, uint128 stream) noexcept { seed(state, stream); }
+
+        constexpr void seed(uint64_t seed) noexcept
+        {
+            SplitMix64 seeder(seed);
+            uint128 state = uint128(seeder()) << 64;
+            state |= seeder();
+            uint128 stream = uint128(seeder()) << 64;
+            stream |= seeder();
+            this->seed(state, stream);
+        }
+
+        constexpr void seed(uint128 state, uint128 stream) noexcept
+        {
+            _increment = (stream << 1) | 1;
+            _state = 0;
+            bump();
+            _state += state;
+            bump();
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        constexpr result_type operator()() noexcept
+        {
+            bump();
+            auto value = uint64_t(_state >> 64) ^ uint64_t(_state);
+            auto rotation = unsigned(_state >> 122);
+            return (value >> rotation) | (value << ((64 - rotation) & 63));
+        }
+    };
+
+
+    /*!
+     * @class WyRand
+     * wyrand 64-bit generator with 64 bits of state (Wang Yi). The fastest of engines, passes BigCrush and PractRand
+     */
+    class WyRand
+    {
+        uint64_t _state;
+
+    public:
+        typedef uint64_t result_type;
+
+        constexpr explicit WyRand(uint64_t seed = 0) noexcept : _state(seed) {}
+
+        constexpr void seed(uint64_t seed) noexcept { _state = seed; }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        constexpr result_type operator()() noexcept
+        {
+            _state += 0xA0761D6478BD642Full;
+            auto product = (unsigned __int128)_state * (_state ^ 0xE7037ED1A0B428DBull);
+            return uint64_t(product >> 64) ^ uint64_t(product);
+        }
+    };
+
+
+    /*!
+     * @class Xoshiro256StarStarX8
+     * Eight interleaved xoshiro256** lanes advanced together with AVX-512, AVX2 or scalar code chosen at runtime.
+     * Lane i starts from Xoshiro256StarStar(seed) state jumped i times, so lanes never overlap. Output is the
+     * sequence of lane outputs: step 0 lanes 0..7, step 1 lanes 0..7 etc. It doesn't depend on chosen instruction
+     * set
+     */
+    class Xoshiro256StarStarX8
+    {
+    public:
+        typedef uint64_t result_type;
+
+        static constexpr size_t lanes = 8;
+
+        /*!
+         * Instruction set of lanes kernel
+         */
+        enum class Isa
+        {
+            Scalar,
+            Avx2,
+            Avx512
+        };
+
+        explicit Xoshiro256StarStarX8(uint64_t seed = 0) noexcept;
+
+        /*!
+         * Construct with lane 0 in engine state, lane i in engine state jumped i times
+         */
+        explicit Xoshiro256StarStarX8(const Xoshiro256StarStar &engine) noexcept;
+
+        void seed(uint64_t seed) noexcept;
+
+        void seed(Xoshiro256StarStar engine) noexcept;
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() noexcept;
+
+        /*!
+         * Fill buffer with the next (size + 7) / 8 outputs in little-endian byte order. The last output is
+         * truncated if size is not multiple of 8
+         * @param buffer Buffer to fill, may be unaligned
+         * @param size Buffer size in bytes
+         */
+        void fill(void *buffer, size_t size) noexcept;
+
+        /*!
+         * Get the best instruction set supported by CPU
+         */
+        static Isa bestIsa() noexcept;
+
+        Isa isa() const noexcept { return _isa; }
+
+        /*!
+         * Choose instruction set. Unsupported instruction set is replaced by the best supported one
+         */
+        void setIsa(Isa isa) noexcept;
+
+    private:
+        typedef void (*Kernel)(uint64_t (&state)[4][lanes], void *output, size_t steps);
+
+        alignas(64) uint64_t _state[4][lanes];
+        alignas(64) uint64_t _buffer[lanes];
+        size_t _position = lanes;
+        Isa _isa;
+        Kernel _kernel;
+
+        size_t takeBuffered(uint8_t *buffer, size_t size) noexcept;
+    };
+
+
+    /*!
+     * @class Philox4x32
+     * Philox4x32-10 counter-based generator (Salmon et al., Random123). Output word i of stream s is a pure function
+     * of key, s and i, so any word or range of words is computed in O(1) without generating preceding ones, and
+     * streams with distinct numbers never overlap. Each 128-bit counter block gives two 64-bit outputs
+     */
+    class Philox4x32
+    {
+    public:
+        typedef uint64_t result_type;
+        typedef std::array<uint32_t, 4> Block;
+        typedef std::array<uint32_t, 2> Key;
+
+        /*!
+         * @param seed Key of generator
+         * @param stream Number of stream
+         */
+        constexpr explicit Philox4x32(uint64_t seed = 0, uint64_t stream = 0) noexcept { this->seed(seed, stream); }
+
+        constexpr void seed(uint64_t seed, uint64_t stream = 0) noexcept
+        {
+            _key = {uint32_t(seed), uint32_t(seed >> 32)};
+            _stream = stream;
+            _position = 0;
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        /*!
+         * Apply Philox4x32-10 bijection to counter block
+         */
+        static constexpr Block block(Block counter, Key key) noexcept
+        {
+            for (int round = 0; round < 10; ++round)
+            {
+                if (round)
+                {
+                    key[0] += 0x9E3779B9u;
+                    key[1] += 0xBB67AE85u;
+                }
+                uint64_t product0 = uint64_t(0xD2511F53u) * counter[0];
+                uint64_t product1 = uint64_t(0xCD9E8D57u) * counter[2];
+                counter = {uint32_t(product1 >> 32) ^ counter[1] ^ key[0], uint32_t(product1),
+                           uint32_t(product0 >> 32) ^ counter[3] ^ key[1], uint32_t(product0)};
+            }
+            return counter;
+        }
+
+        /*!
+         * Get output with given index in current stream. Doesn't change generator position
+         */
+        constexpr result_type at(uint64_t index) const noexcept
+        {
+            auto words = blockAt(index >> 1);
+            return index & 1 ? words[1] : words[0];
+        }
+
+        constexpr result_type operator()() noexcept { return at(_position++); }
+
+        /*!
+         * Write outputs [first, last) of current stream to output. Doesn't change generator position
+         */
+        constexpr void fill(uint64_t first, uint64_t last, uint64_t *output) const noexcept
+        {
+            if (first < last && first & 1)
+                *output++ = at(first++);
+            for (; last - first >= 2; first += 2)
+            {
+                auto words = blockAt(first >> 1);
+                *output++ = words[0];
+                *output++ = words[1];
+            }
+            if (first < last)
+                *output = at(first);
+        }
+
+        /*!
+         * Fill buffer with the next (size + 7) / 8 outputs in little-endian byte order. The last output is
+         * truncated if size is not multiple of 8
+         * @param buffer Buffer to fill, may be unaligned
+         * @param size Buffer size in bytes
+         */
+        void fill(void *buffer, size_t size) noexcept;
+
+        /*!
+         * Skip count outputs
+         */
+        constexpr void discard(uint64_t count) noexcept { _position += count; }
+
+        /*!
+         * Move to output with given index
+         */
+        constexpr void seek(uint64_t index) noexcept { _position = index; }
+
+        /*!
+         * Get index of the next output
+         */
+        constexpr uint64_t position() const noexcept { return _position; }
+
+        /*!
+         * Get generator with the same key positioned at the beginning of other stream
+         */
+        constexpr Philox4x32 stream(uint64_t stream) const noexcept
+        {
+            Philox4x32 result(*this);
+            result._stream = stream;
+            result._position = 0;
+            return result;
+        }
+
+        constexpr uint64_t streamNumber() const noexcept { return _stream; }
+
+        constexpr bool operator==(const Philox4x32 &other) const noexcept
+        {
+            return _key[0] == other._key[0] && _key[1] == other._key[1] && _stream == other._stream &&
+                   _position == other._position;
+        }
+
+        constexpr bool operator!=(const Philox4x32 &other) const noexcept { return !(*this == other); }
+
+    private:
+        Key _key{};
+        uint64_t _stream = 0;
+        uint64_t _position = 0;
+
+        constexpr std::array<uint64_t, 2> blockAt(uint64_t counter) const noexcept
+        {
+            auto words = block({uint32_t(counter), uint32_t(counter >> 32), uint32_t(_stream),
+                                uint32_t(_stream >> 32)}, _key);
+            return {words[0] | (uint64_t(words[1]) << 32), words[2] | (uint64_t(words[3]) << 32)};
+        }
+    };
+
+
+    /*!
+     * @class PooledEngine
+     * Engine adapter keeping cache line aligned pool of pre-generated words. The pool is refilled by one bulk
+     * fill of the underlying engine when exhausted, so a call is a load and an index increment in all but one of
+     * PoolSize calls. Output is exactly the output of underlying engine
+     * @tparam Engine Full range 64-bit engine, engines with fill(void *buffer, size_t size) method refill in bulk
+     * @tparam PoolSize Count of words in pool
+     */
+    template<typename Engine = Xoshiro256StarStarX8, size_t PoolSize = 512>
+    class PooledEngine
+    {
+        static_assert(Engine::min() == 0 && Engine::max() == std::numeric_limits<uint64_t>::max());
+        static_assert(PoolSize > 0);
+
+        alignas(64) uint64_t _pool[PoolSize];
+        size_t _position = PoolSize;
+        Engine _engine;
+
+        void engineFill(void *buffer, size_t size) noexcept
+        {
+            if constexpr (has_fill<Engine>::value)
+                _engine.fill(buffer, size);
+            else
+            {
+                auto *bytes = static_cast<uint8_t *>(buffer);
+                for (; size >= sizeof(uint64_t); bytes += sizeof(uint64_t), size -= sizeof(uint64_t))
+                {
+                    uint64_t word = _engine();
+                    std::memcpy(bytes, &word, sizeof(word));
+                }
+                if (size)
+                {
+                    uint64_t word = _engine();
+                    std::memcpy(bytes, &word, size);
+                }
+            }
+        }
+
+        void refill() noexcept
+        {
+            engineFill(_pool, sizeof(_pool));
+            _position = 0;
+        }
+
+    public:
+        typedef uint64_t result_type;
+        typedef Engine engine_type;
+
+        static constexpr size_t poolSize = PoolSize;
+
+        explicit PooledEngine(uint64_t seed = 0) noexcept : _engine(seed) {}
+
+        explicit PooledEngine(const Engine &engine) noexcept : _engine(engine) {}
+
+        void seed(uint64_t seed) noexcept
+        {
+            _engine.seed(seed);
+            _position = PoolSize;
+        }
+
+        static constexpr result_type min() noexcept { return 0; }
+        static constexpr result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() noexcept
+        {
+            if (__builtin_expect(_position == PoolSize, 0))
+                refill();
+            return _pool[_position++];
+        }
+
+        /*!
+         * Fill buffer with the next (size + 7) / 8 outputs in little-endian byte order. The last output is
+         * truncated if size is not multiple of 8. Large buffers are filled by underlying engine directly
+         * @param buffer Buffer to fill, may be unaligned
+         * @param size Buffer size in bytes
+         */
+        void fill(void *buffer, size_t size) noexcept
+        {
+            auto *bytes = static_cast<uint8_t *>(buffer);
+            size_t pooled = std::min(size, (PoolSize - _position) * sizeof(uint64_t));
+            std::memcpy(bytes, _pool + _position, pooled);
+            _position += (pooled + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+            bytes += pooled;
+            size -= pooled;
+
+            if (size >= sizeof(_pool))
+            {
+                size_t direct = size - size % sizeof(uint64_t);
+                engineFill(bytes, direct);
+                bytes += direct;
+                size -= direct;
+            }
+            if (size)
+            {
+                refill();
+                std::memcpy(bytes, _pool, size);
+                _position = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+            }
+        }
+
+        /*!
+         * Get count of words left in pool
+         */
+        size_t available() const noexcept { return PoolSize - _position; }
+
+        /*!
+         * Get underlying engine. Its state is ahead of pooled words
+         */
+        const Engine &engine() const noexcept { return _engine; }
+    };
+}
+
+#endif //EXPLORATIONS_ENGINES_H
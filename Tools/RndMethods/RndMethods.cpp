@@ -15,15 +15,65 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <RndMethods.h>
+#include <mutex>
+#include <thread>
+#include <system_error>
 
 rndMethods::RandomGenerator rndMethods::randomGenerator;
 
-rndMethods::RandomGenerator::RandomGenerator() noexcept : _uid(std::numeric_limits<PRNG_TYPE>::min(),
-                                                              std::numeric_limits<PRNG_TYPE>::max())
+rndMethods::Xoshiro256StarStar rndMethods::nextThreadEngine(size_t streamCount) noexcept
 {
-    std::mt19937 generator;
-    std::random_device randomDevice;
-    uint seed = randomDevice();
-    generator.seed(seed);
-    _generator = generator;
-}
\ No newline at end of file
+    static std::mutex mutex;
+    static Xoshiro256StarStar master = []()
+    {
+        std::random_device randomDevice;
+        uint64_t seed = randomDevice();
+        return Xoshiro256StarStar((seed << 32) | randomDevice());
+    }();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    Xoshiro256StarStar res = master;
+    for (size_t i = 0; i < streamCount; ++i)
+        master.jump();
+    return res;
+}
+
+void rndMethods::parallelRandomData(uint8_t *buffer, size_t size, uint64_t seed, size_t threadCount)
+{
+    size_t blockCount = (size + parallelBlockSize - 1) / parallelBlockSize;
+    if (threadCount == 0)
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    threadCount = std::max<size_t>(std::min(threadCount, blockCount), 1);
+
+    auto worker = [buffer, size, seed, blockCount, threadCount](size_t index)
+    {
+        size_t firstBlock = blockCount * index / threadCount;
+        size_t lastBlock = blockCount * (index + 1) / threadCount;
+        Xoshiro256StarStar blockEngine(seed);
+        for (size_t block = 0; block < firstBlock; ++block)
+            blockEngine.longJump();
+        for (size_t block = firstBlock; block < lastBlock; ++block)
+        {
+            size_t offset = block * parallelBlockSize;
+            Xoshiro256StarStarX8(blockEngine).fill(buffer + offset, std::min(parallelBlockSize, size - offset));
+            blockEngine.longJump();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    size_t started = 1;
+    try
+    {
+        for (; started < threadCount; ++started)
+            workers.emplace_back(worker, started);
+    }
+    catch (const std::system_error &)
+    {
+    }
+    for (size_t i = started; i < threadCount; ++i)
+        worker(i);
+    worker(0);
+    for (auto &thread: workers)
+        thread.join();
+}
@@ -19,29 +19,71 @@
 
 #include <random>
 #include <cassert>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <Engines.h>
+#include <Distributions.h>
 
 #ifndef PRNG_TYPE
 #define PRNG_TYPE uint32_t
 #endif // PRNG_TYPE
 
-#define RANDOM_VALUE rndMethods::randomGenerator.randomValue
-#define RANDOM_DATA rndMethods::randomGenerator.randomData
+#ifdef PRNG_POOLED
+#define RANDOM_VALUE rndMethods::threadPooledRandomGenerator().randomValue
+#define RANDOM_DATA rndMethods::threadPooledRandomGenerator().randomData
+#else
+#define RANDOM_VALUE rndMethods::threadRandomGenerator().randomValue
+#define RANDOM_DATA rndMethods::threadRandomGenerator().randomData
+#endif // PRNG_POOLED
 
 
 namespace rndMethods
 {
     /*!
-     * @class RandomGenerator
+     * @class BasicRandomGenerator
      * Used to generate random values,random data vectors or fill provided memory chunk with random values
+     * @tparam Engine Random number engine: std::mt19937 (default), Xoshiro256StarStar, Pcg64, SplitMix64, WyRand
+     *         or any other engine satisfying UniformRandomBitGenerator requirements and seedable by integer.
+     *         Engines with fill(void *buffer, size_t size) method (Xoshiro256StarStarX8) fill memory in bulk
      */
-    class RandomGenerator
+    template<typename Engine = std::mt19937>
+    class BasicRandomGenerator
     {
-        std::mt19937 _generator;
+        typedef std::conditional_t<Engine::max() == std::numeric_limits<uint64_t>::max(), uint64_t, uint32_t> wordType;
+
+        Engine _generator;
         std::uniform_int_distribution<PRNG_TYPE> _uid;
 
+        /*!
+         * Generate word of random bits. Engines with full range output are used directly
+         */
+        wordType randomWord();
+
     public:
+        typedef Engine engine_type;
+
+        /*!
+         * Construct generator seeded by std::random_device
+         */
+        BasicRandomGenerator() noexcept;
 
-        RandomGenerator() noexcept;
+        /*!
+         * Construct generator with fixed seed. Generated sequence is reproducible
+         * @param seed Engine seed
+         */
+        explicit BasicRandomGenerator(uint64_t seed) noexcept;
+
+        /*!
+         * Construct generator with engine in given state
+         * @param engine Engine to copy
+         */
+        explicit BasicRandomGenerator(const Engine &engine) noexcept;
+
+        /*!
+         * Get underlying engine
+         */
+        Engine &engine() noexcept { return _generator; }
 
         /*!
          * Generates value of template parameter type
@@ -53,13 +95,37 @@ namespace rndMethods
         constexpr valueType randomValue();
 
         /*!
-         * fill provided memory chunk with random values
+         * Generate value of distribution (UniformIntDistribution, NormalDistribution, ZipfDistribution etc.)
+         * @param distribution Distribution to draw value from
+         * @return Generated value
+         */
+        template<typename Distribution>
+        typename Distribution::result_type randomValue(Distribution &distribution)
+        {
+            return distribution(_generator);
+        }
+
+        /*!
+         * fill provided memory chunk with random values. Memory is filled with whole engine words, only unaligned
+         * head and tail take partial words
          * @tparam valueType Pointer to type of values to be generated
          * @param dataLength Provided memory chunk size
          */
         template<typename valueType = uint8_t *>
         void constexpr randomData(valueType pointerToData, size_t dataLength);
 
+        /*!
+         * Fill provided memory chunk with random values in parallel. Memory is split into parallelBlockSize blocks,
+         * block i is filled by Xoshiro256StarStarX8 lanes started from Xoshiro256StarStar(seed) state long jumped
+         * i times. Result depends only on seed and memory chunk size: neither on threadCount nor on Engine
+         * @tparam valueType Pointer to type of values to be generated
+         * @param dataLength Provided memory chunk size
+         * @param seed Seed of generated data
+         * @param threadCount Count of threads to fill memory with. 0 means std::thread::hardware_concurrency()
+         */
+        template<typename valueType = uint8_t *>
+        static void randomData(valueType pointerToData, size_t dataLength, uint64_t seed, size_t threadCount = 0);
+
         /*!
          * Generate vector of values of template parameter type
          * @tparam valueType Type of values to be generated
@@ -68,30 +134,168 @@ namespace rndMethods
          */
         template<typename valueType = uint8_t>
         std::vector<valueType> randomData(size_t count);
+
+        /*!
+         * Fill output with values of distribution
+         * @param distribution Distribution to draw values from
+         * @param output Memory chunk for count values
+         * @param count Values count to be generated
+         */
+        template<typename Distribution>
+        void randomData(Distribution &distribution, typename Distribution::result_type *output, size_t count)
+        {
+            distribution.fill(_generator, output, count);
+        }
     };
 
+    typedef BasicRandomGenerator<> RandomGenerator;
+
     extern RandomGenerator randomGenerator;
+
+    /*!
+     * Size of blocks filled independently by parallel randomData
+     */
+    constexpr size_t parallelBlockSize = size_t(1) << 20;
+
+    /*!
+     * Fill buffer in parallel (see BasicRandomGenerator::randomData)
+     * @param buffer Buffer to fill
+     * @param size Buffer size in bytes
+     * @param seed Seed of generated data
+     * @param threadCount Count of threads. 0 means std::thread::hardware_concurrency(). If a thread can't be
+     * started, its blocks are filled by the calling thread, so data doesn't depend on it
+     */
+    void parallelRandomData(uint8_t *buffer, size_t size, uint64_t seed, size_t threadCount);
+
+    /*!
+     * Generator type used by RANDOM_VALUE and RANDOM_DATA
+     */
+    typedef BasicRandomGenerator<Xoshiro256StarStar> ThreadRandomGenerator;
+
+    /*!
+     * Get engine for a new thread generator: the next 2^128 outputs long stream of a master engine seeded by
+     * std::random_device. Streams of different threads never overlap
+     * @param streamCount Count of consecutive streams reserved, the engine jumped i times gives stream i
+     * @return Engine with unique stream
+     */
+    Xoshiro256StarStar nextThreadEngine(size_t streamCount = 1) noexcept;
+
+    /*!
+     * Get generator of the current thread. Generator is created and seeded on the first call in the thread,
+     * so threads share neither state nor locks afterwards
+     * @return Thread local generator
+     */
+    inline ThreadRandomGenerator &threadRandomGenerator() noexcept
+    {
+        alignas(64) thread_local ThreadRandomGenerator generator(nextThreadEngine());
+        return generator;
+    }
+
+    typedef BasicRandomGenerator<PooledEngine<>> PooledRandomGenerator;
+
+    /*!
+     * Get pooled generator of the current thread: values are taken from a pool refilled by SIMD lanes. Used by
+     * RANDOM_VALUE and RANDOM_DATA if PRNG_POOLED is defined
+     * @return Thread local generator
+     */
+    inline PooledRandomGenerator &threadPooledRandomGenerator() noexcept
+    {
+        thread_local PooledRandomGenerator generator{
+                PooledEngine<>(Xoshiro256StarStarX8(nextThreadEngine(Xoshiro256StarStarX8::lanes)))};
+        return generator;
+    }
 }
 
 
+template<typename Engine>
+rndMethods::BasicRandomGenerator<Engine>::BasicRandomGenerator() noexcept :
+        _uid(std::numeric_limits<PRNG_TYPE>::min(), std::numeric_limits<PRNG_TYPE>::max())
+{
+    std::random_device randomDevice;
+    uint64_t seed = randomDevice();
+    seed = (seed << 32) | randomDevice();
+    _generator.seed(typename Engine::result_type(seed));
+}
+
+template<typename Engine>
+rndMethods::BasicRandomGenerator<Engine>::BasicRandomGenerator(uint64_t seed) noexcept :
+        _uid(std::numeric_limits<PRNG_TYPE>::min(), std::numeric_limits<PRNG_TYPE>::max())
+{
+    _generator.seed(typename Engine::result_type(seed));
+}
+
+template<typename Engine>
+rndMethods::BasicRandomGenerator<Engine>::BasicRandomGenerator(const Engine &engine) noexcept :
+        _generator(engine), _uid(std::numeric_limits<PRNG_TYPE>::min(), std::numeric_limits<PRNG_TYPE>::max())
+{
+}
+
+template<typename Engine>
+typename rndMethods::BasicRandomGenerator<Engine>::wordType rndMethods::BasicRandomGenerator<Engine>::randomWord()
+{
+    if constexpr (Engine::min() == 0 && Engine::max() == std::numeric_limits<wordType>::max())
+        return wordType(_generator());
+    else
+        return std::uniform_int_distribution<wordType>()(_generator);
+}
+
+template<typename Engine>
 template<typename valueType>
-constexpr valueType rndMethods::RandomGenerator::randomValue()
+constexpr valueType rndMethods::BasicRandomGenerator<Engine>::randomValue()
 {
     static_assert(std::is_convertible_v<PRNG_TYPE, valueType>);
-    return static_cast<valueType>(_uid(_generator));
+    if constexpr (std::is_unsigned_v<PRNG_TYPE> && sizeof(PRNG_TYPE) <= sizeof(wordType) &&
+                  Engine::min() == 0 && Engine::max() == std::numeric_limits<wordType>::max())
+        return static_cast<valueType>(static_cast<PRNG_TYPE>(_generator()));
+    else
+        return static_cast<valueType>(_uid(_generator));
 }
 
+template<typename Engine>
 template<typename valueType>
-void constexpr rndMethods::RandomGenerator::randomData(valueType pointerToData, size_t dataLength)
+void constexpr rndMethods::BasicRandomGenerator<Engine>::randomData(valueType pointerToData, size_t dataLength)
 {
     size_t dataSize = dataLength * sizeof(decltype(*pointerToData));
     auto *buffer = reinterpret_cast<uint8_t *>(pointerToData);
-    for (size_t i = 0; i < dataSize; ++i)
-        buffer[i] = RANDOM_VALUE<uint8_t>();
+    if constexpr (has_fill<Engine>::value)
+    {
+        _generator.fill(buffer, dataSize);
+        return;
+    }
+
+    size_t head = std::min(dataSize, (alignof(wordType) - reinterpret_cast<uintptr_t>(buffer) % alignof(wordType)) %
+                                     alignof(wordType));
+    if (head != 0)
+    {
+        auto word = randomWord();
+        std::memcpy(buffer, &word, head);
+    }
+
+    size_t i = head;
+    for (; i + sizeof(wordType) <= dataSize; i += sizeof(wordType))
+    {
+        auto word = randomWord();
+        std::memcpy(buffer + i, &word, sizeof(word));
+    }
+    if (i < dataSize)
+    {
+        auto word = randomWord();
+        std::memcpy(buffer + i, &word, dataSize - i);
+    }
+}
+
+template<typename Engine>
+template<typename valueType>
+void rndMethods::BasicRandomGenerator<Engine>::randomData(valueType pointerToData, size_t dataLength, uint64_t seed,
+                                                          size_t threadCount)
+{
+    size_t dataSize = dataLength * sizeof(decltype(*pointerToData));
+    parallelRandomData(reinterpret_cast<uint8_t *>(pointerToData), dataSize, seed, threadCount);
 }
 
+template<typename Engine>
 template<typename valueType>
-std::vector<valueType> rndMethods::RandomGenerator::randomData(size_t count)
+std::vector<valueType> rndMethods::BasicRandomGenerator<Engine>::randomData(size_t count)
 {
     std::vector<valueType> result(count);
     randomData<valueType *>(result.data(), count);
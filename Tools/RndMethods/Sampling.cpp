@@ -0,0 +1,138 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <Sampling.h>
+#include <numeric>
+#include <stdexcept>
+
+
+rndMethods::AliasTable::AliasTable(std::vector<double> weights) : _weights(std::move(weights))
+{
+    if (_weights.empty())
+        throw std::invalid_argument("Alias table needs at least one weight");
+    for (double weight: _weights)
+        validate(weight);
+
+    _blockShift = 4;
+    while ((size_t(1) << (2 * _blockShift)) < _weights.size())
+        ++_blockShift;
+    size_t blockCount = ((_weights.size() - 1) >> _blockShift) + 1;
+    _columns.resize(_weights.size());
+    _blockWeights.resize(blockCount);
+    _blockColumns.resize(blockCount);
+    for (size_t block = 0; block < blockCount; ++block)
+        rebuildBlock(block);
+    if (totalWeight() <= 0)
+        throw std::invalid_argument("Sum of weights must be positive");
+    rebuildTop();
+}
+
+void rndMethods::AliasTable::setWeight(size_t index, double weight)
+{
+    setWeights({{index, weight}});
+}
+
+void rndMethods::AliasTable::setWeights(const std::vector<std::pair<size_t, double>> &updates)
+{
+    std::vector<std::pair<size_t, double>> previous;
+    previous.reserve(updates.size());
+    for (auto &[index, weight]: updates)
+    {
+        if (index >= _weights.size())
+            throw std::out_of_range("Weight index is out of range");
+        validate(weight);
+    }
+
+    std::vector<size_t> blocks;
+    blocks.reserve(updates.size());
+    for (auto &[index, weight]: updates)
+    {
+        previous.emplace_back(index, _weights[index]);
+        _weights[index] = weight;
+        blocks.push_back(index >> _blockShift);
+    }
+    std::sort(blocks.begin(), blocks.end());
+    blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+    for (size_t block: blocks)
+        rebuildBlock(block);
+
+    if (totalWeight() <= 0)
+    {
+        for (auto it = previous.rbegin(); it != previous.rend(); ++it)
+            _weights[it->first] = it->second;
+        for (size_t block: blocks)
+            rebuildBlock(block);
+        throw std::invalid_argument("Sum of weights must be positive");
+    }
+    rebuildTop();
+}
+
+double rndMethods::AliasTable::totalWeight() const noexcept
+{
+    return std::accumulate(_blockWeights.begin(), _blockWeights.end(), 0.0);
+}
+
+void rndMethods::AliasTable::validate(double weight)
+{
+    if (!std::isfinite(weight) || weight < 0)
+        throw std::invalid_argument("Weight must be finite and non-negative");
+}
+
+void rndMethods::AliasTable::buildColumns(const double *weights, size_t count, Column *columns)
+{
+    double sum = std::accumulate(weights, weights + count, 0.0);
+    _scaled.resize(count);
+    _small.clear();
+    _large.clear();
+    for (size_t i = 0; i < count; ++i)
+    {
+        _scaled[i] = weights[i] * double(count) / sum;
+        (_scaled[i] < 1 ? _small : _large).push_back(i);
+    }
+
+    while (!_small.empty() && !_large.empty())
+    {
+        size_t small = _small.back();
+        size_t large = _large.back();
+        _small.pop_back();
+        columns[small] = {uint64_t(std::ldexp(std::max(_scaled[small], 0.0), 64)), large};
+        _scaled[large] += _scaled[small] - 1;
+        if (_scaled[large] < 1)
+        {
+            _large.pop_back();
+            _small.push_back(large);
+        }
+    }
+    for (size_t i: _large)
+        columns[i] = {std::numeric_limits<uint64_t>::max(), i};
+    for (size_t i: _small)
+        columns[i] = {std::numeric_limits<uint64_t>::max(), i};
+}
+
+void rndMethods::AliasTable::rebuildBlock(size_t block)
+{
+    size_t begin = block << _blockShift;
+    size_t count = std::min(_weights.size() - begin, size_t(1) << _blockShift);
+    _blockWeights[block] = std::accumulate(_weights.begin() + begin, _weights.begin() + begin + count, 0.0);
+    if (_blockWeights[block] > 0)
+        buildColumns(_weights.data() + begin, count, _columns.data() + begin);
+}
+
+void rndMethods::AliasTable::rebuildTop()
+{
+    buildColumns(_blockWeights.data(), _blockWeights.size(), _blockColumns.data());
+}
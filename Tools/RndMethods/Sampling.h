@@ -0,0 +1,329 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef EXPLORATIONS_SAMPLING_H
+#define EXPLORATIONS_SAMPLING_H
+
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <system_error>
+#include <iterator>
+#include <tuple>
+#include <algorithm>
+#include <Engines.h>
+#include <Distributions.h>
+
+
+namespace rndMethods
+{
+    /*!
+     * Generate two values in [0, bound1) and [0, bound2) from one engine word (Brackett-Rozinsky, Lemire). The word
+     * is multiplied by bound1, then the low half of product by bound2; rejection keeps pair unbiased
+     * @note bound1 * bound2 must not exceed 2^64
+     */
+    template<typename Engine>
+    inline std::pair<uint64_t, uint64_t> boundedPair(Engine &engine, uint64_t bound1, uint64_t bound2)
+    {
+        auto draw = [&engine, bound1, bound2]()
+        {
+            auto first = (unsigned __int128)randomBits(engine) * bound1;
+            auto second = (unsigned __int128)uint64_t(first) * bound2;
+            return std::make_tuple(uint64_t(first >> 64), uint64_t(second >> 64), uint64_t(second));
+        };
+        auto [value1, value2, leftover] = draw();
+        uint64_t product = bound1 * bound2;
+        if (leftover < product)
+        {
+            uint64_t threshold = -product % product;
+            while (leftover < threshold)
+                std::tie(value1, value2, leftover) = draw();
+        }
+        return {value1, value2};
+    }
+
+    /*!
+     * Shuffle range by Fisher-Yates algorithm. Two swap positions are drawn from one engine word while the product
+     * of bounds fits 64 bits
+     * @param first, last Random access range
+     * @param engine Engine satisfying UniformRandomBitGenerator requirements
+     */
+    template<typename RandomIt, typename Engine>
+    void shuffle(RandomIt first, RandomIt last, Engine &engine)
+    {
+        auto count = uint64_t(last - first);
+        for (; count > uint64_t(1) << 32; --count)
+            std::iter_swap(first + (count - 1), first + boundedValue(engine, count));
+        for (; count > 1; count -= 2)
+        {
+            auto [value1, value2] = boundedPair(engine, count, count - 1);
+            std::iter_swap(first + (count - 1), first + value1);
+            std::iter_swap(first + (count - 2), first + value2);
+        }
+    }
+
+    /*!
+     * Choose uniform random sample of min(k, n) elements from n elements by Algorithm L (Li): the count of skipped
+     * elements is drawn directly, so the engine is used O(k log(n / k)) times. Input is passed once
+     * @param first, last Input range, may be single pass (e.g. std::istream_iterator)
+     * @param output Random access range for k elements
+     * @param k Sample size
+     * @param engine Engine satisfying UniformRandomBitGenerator requirements
+     * @return Count of sampled elements: min(k, n)
+     */
+    template<typename InputIt, typename RandomIt, typename Engine>
+    size_t reservoirSample(InputIt first, InputIt last, RandomIt output, size_t k, Engine &engine)
+    {
+        size_t filled = 0;
+        for (; filled < k && first != last; ++first, ++filled)
+            output[filled] = *first;
+        if (filled < k)
+            return filled;
+
+        auto nextWeight = [&engine, k]()
+        {
+            return std::exp(std::log(openUnitDouble(randomBits(engine))) / double(k));
+        };
+        double weight = nextWeight();
+        while (true)
+        {
+            double skip = std::floor(std::log(openUnitDouble(randomBits(engine))) / std::log1p(-weight));
+            for (double i = 0; i < skip && first != last; ++i)
+                ++first;
+            if (first == last)
+                return k;
+            output[boundedValue(engine, k)] = *first;
+            ++first;
+            weight *= nextWeight();
+        }
+    }
+
+
+    /*!
+     * @class AliasTable
+     * Weighted sampling by Vose alias method in O(1): one engine word chooses column and accepts it or its alias.
+     * Columns are split into blocks with own alias tables, chosen by top level alias table of block weights, so
+     * changing weights rebuilds only touched blocks and top level table: O(sqrt(n)) per update
+     */
+    class AliasTable
+    {
+    public:
+        /*!
+         * @param weights Non-negative weights with positive sum
+         * @throw std::invalid_argument if weights are negative, not finite or all zeros
+         */
+        explicit AliasTable(std::vector<double> weights);
+
+        /*!
+         * Get random index with probability proportional to its weight
+         */
+        template<typename Engine>
+        size_t operator()(Engine &engine) const;
+
+        /*!
+         * Change weight of one element
+         * @throw std::invalid_argument if weight is invalid or all weights become zeros
+         */
+        void setWeight(size_t index, double weight);
+
+        /*!
+         * Change weights of several elements rebuilding every touched block once
+         * @param updates Pairs of index and new weight
+         * @throw std::invalid_argument if weights are invalid or all weights become zeros
+         */
+        void setWeights(const std::vector<std::pair<size_t, double>> &updates);
+
+        double weight(size_t index) const noexcept { return _weights[index]; }
+
+        /*!
+         * Get sum of weights
+         */
+        double totalWeight() const noexcept;
+
+        size_t size() const noexcept { return _weights.size(); }
+
+    private:
+        struct Column
+        {
+            uint64_t threshold;
+            size_t alias;
+        };
+
+        std::vector<double> _weights;
+        std::vector<double> _blockWeights;
+        std::vector<Column> _columns;
+        std::vector<Column> _blockColumns;
+        std::vector<size_t> _small, _large;
+        std::vector<double> _scaled;
+        size_t _blockShift;
+
+        static void validate(double weight);
+
+        template<typename Engine>
+        static size_t pick(Engine &engine, const Column *columns, size_t count)
+        {
+            auto product = (unsigned __int128)randomBits(engine) * count;
+            auto column = size_t(product >> 64);
+            return uint64_t(product) < columns[column].threshold ? column : columns[column].alias;
+        }
+
+        void buildColumns(const double *weights, size_t count, Column *columns);
+
+        void rebuildBlock(size_t block);
+
+        void rebuildTop();
+    };
+
+
+    /*!
+     * Shuffle array in parallel. Elements are scattered to buckets chosen at random in fixed chunks, then every
+     * bucket is shuffled in place. Count of chunks and buckets depends only on count, so permutation depends only
+     * on seed and count, not on threadCount. Small arrays are shuffled on the calling thread
+     * @param data Array of default constructible, move assignable elements
+     * @param count Elements count
+     * @param seed Seed of permutation
+     * @param threadCount Count of threads. 0 means std::thread::hardware_concurrency()
+     */
+    template<typename T>
+    void parallelShuffle(T *data, size_t count, uint64_t seed, size_t threadCount = 0);
+
+    /*!
+     * Split tasks [0, taskCount) into contiguous ranges and run function(begin, end) for every range on its own
+     * thread. The calling thread takes the first range and the ranges of threads that couldn't be started
+     */
+    template<typename Function>
+    void runParallel(size_t taskCount, size_t threadCount, Function &&function)
+    {
+        if (threadCount == 0)
+            threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        threadCount = std::max<size_t>(std::min(threadCount, taskCount), 1);
+
+        std::vector<std::thread> workers;
+        workers.reserve(threadCount - 1);
+        size_t started = 1;
+        try
+        {
+            for (; started < threadCount; ++started)
+                workers.emplace_back(function, taskCount * started / threadCount,
+                                     taskCount * (started + 1) / threadCount);
+        }
+        catch (const std::system_error &)
+        {
+        }
+        for (size_t i = started; i < threadCount; ++i)
+            function(taskCount * i / threadCount, taskCount * (i + 1) / threadCount);
+        function(size_t(0), taskCount / threadCount);
+        for (auto &worker: workers)
+            worker.join();
+    }
+}
+
+
+template<typename Engine>
+size_t rndMethods::AliasTable::operator()(Engine &engine) const
+{
+    size_t block = pick(engine, _blockColumns.data(), _blockColumns.size());
+    size_t begin = block << _blockShift;
+    size_t count = std::min(_weights.size() - begin, size_t(1) << _blockShift);
+    return begin + pick(engine, _columns.data() + begin, count);
+}
+
+template<typename T>
+void rndMethods::parallelShuffle(T *data, size_t count, uint64_t seed, size_t threadCount)
+{
+    constexpr size_t bucketElements = 1 << 16;
+    if (count < 2 * bucketElements)
+    {
+        Xoshiro256StarStar engine(seed);
+        shuffle(data, data + count, engine);
+        return;
+    }
+
+    size_t bucketCount = std::clamp<size_t>(count / bucketElements, 2, 1024);
+    size_t chunkCount = std::clamp<size_t>(count / bucketElements, 1, 128);
+    auto chunkBegin = [count, chunkCount](size_t chunk) { return count * chunk / chunkCount; };
+    std::vector<uint16_t> buckets(count);
+    std::vector<size_t> offsets(chunkCount * bucketCount, 0);
+
+    runParallel(chunkCount, threadCount, [&](size_t firstChunk, size_t lastChunk)
+    {
+        Xoshiro256StarStar chunkEngine(seed);
+        for (size_t chunk = 0; chunk < firstChunk; ++chunk)
+            chunkEngine.longJump();
+        for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+        {
+            Xoshiro256StarStar engine = chunkEngine;
+            size_t *counts = offsets.data() + chunk * bucketCount;
+            for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i)
+            {
+                buckets[i] = uint16_t(boundedValue(engine, bucketCount));
+                ++counts[buckets[i]];
+            }
+            chunkEngine.longJump();
+        }
+    });
+
+    std::vector<size_t> bucketBegin(bucketCount + 1, 0);
+    size_t position = 0;
+    for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+    {
+        bucketBegin[bucket] = position;
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            size_t chunkCounts = offsets[chunk * bucketCount + bucket];
+            offsets[chunk * bucketCount + bucket] = position;
+            position += chunkCounts;
+        }
+    }
+    bucketBegin[bucketCount] = position;
+
+    std::vector<T> scattered(count);
+    runParallel(chunkCount, threadCount, [&](size_t firstChunk, size_t lastChunk)
+    {
+        for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk)
+        {
+            size_t *chunkOffsets = offsets.data() + chunk * bucketCount;
+            for (size_t i = chunkBegin(chunk); i < chunkBegin(chunk + 1); ++i)
+                scattered[chunkOffsets[buckets[i]]++] = std::move(data[i]);
+        }
+    });
+
+    runParallel(bucketCount, threadCount, [&](size_t firstBucket, size_t lastBucket)
+    {
+        Xoshiro256StarStar bucketEngine(seed);
+        bucketEngine.jump();
+        for (size_t bucket = 0; bucket < firstBucket; ++bucket)
+            bucketEngine.longJump();
+        for (size_t bucket = firstBucket; bucket < lastBucket; ++bucket)
+        {
+            Xoshiro256StarStar engine = bucketEngine;
+            T *output = data + bucketBegin[bucket];
+            T *input = scattered.data() + bucketBegin[bucket];
+            size_t size = bucketBegin[bucket + 1] - bucketBegin[bucket];
+            for (size_t i = 0; i < size; ++i)
+            {
+                size_t j = boundedValue(engine, i + 1);
+                if (j != i)
+                    output[i] = std::move(output[j]);
+                output[j] = std::move(input[i]);
+            }
+            bucketEngine.longJump();
+        }
+    });
+}
+
+#endif //EXPLORATIONS_SAMPLING_H
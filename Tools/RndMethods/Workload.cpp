@@ -0,0 +1,145 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <Workload.h>
+#include <stdexcept>
+
+namespace
+{
+    /*!
+     * Encode 4 bytes to 8 hex digits: spread nibbles to bytes, then add '0' and 'a' - '0' - 10 to digits above 9
+     */
+    inline uint64_t hexDigits(const uint8_t *data) noexcept
+    {
+        uint64_t value = (uint64_t(data[0]) << 24) | (uint64_t(data[1]) << 16) | (uint64_t(data[2]) << 8) | data[3];
+        value = (value | (value << 16)) & 0x0000FFFF0000FFFFull;
+        value = (value | (value << 8)) & 0x00FF00FF00FF00FFull;
+        value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        uint64_t letters = ((value + 0x0606060606060606ull) >> 4) & 0x0101010101010101ull;
+        value += 0x3030303030303030ull + letters * ('a' - '0' - 10);
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        value = __builtin_bswap64(value);
+#endif // __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return value;
+    }
+}
+
+
+rndMethods::Alphabet::Alphabet(std::string symbols) : _symbols(std::move(symbols))
+{
+    if (_symbols.empty() || _symbols.size() > 256)
+        throw std::invalid_argument("Alphabet must contain from 1 to 256 symbols");
+    _threshold = uint32_t(65536 % _symbols.size());
+}
+
+const rndMethods::Alphabet &rndMethods::Alphabet::lowercase()
+{
+    static const Alphabet alphabet("abcdefghijklmnopqrstuvwxyz");
+    return alphabet;
+}
+
+const rndMethods::Alphabet &rndMethods::Alphabet::alphanumeric()
+{
+    static const Alphabet alphabet("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz");
+    return alphabet;
+}
+
+const rndMethods::Alphabet &rndMethods::Alphabet::hex()
+{
+    static const Alphabet alphabet("0123456789abcdef");
+    return alphabet;
+}
+
+const rndMethods::Alphabet &rndMethods::Alphabet::printable()
+{
+    static const Alphabet alphabet = []()
+    {
+        std::string symbols;
+        for (char symbol = '!'; symbol <= '~'; ++symbol)
+            symbols += symbol;
+        return Alphabet(symbols);
+    }();
+    return alphabet;
+}
+
+void rndMethods::encodeHex(const uint8_t *data, size_t size, char *output) noexcept
+{
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        uint64_t digits = hexDigits(data + i);
+        std::memcpy(output + i * 2, &digits, sizeof(digits));
+    }
+    if (i < size)
+    {
+        uint8_t tail[4] = {0, 0, 0, 0};
+        std::memcpy(tail, data + i, size - i);
+        uint64_t digits = hexDigits(tail);
+        std::memcpy(output + i * 2, &digits, (size - i) * 2);
+    }
+}
+
+void rndMethods::encodeBase64(const uint8_t *data, size_t size, char *output, bool urlSafe) noexcept
+{
+    static constexpr char standardSymbols[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    static constexpr char urlSymbols[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    const char *symbols = urlSafe ? urlSymbols : standardSymbols;
+
+    size_t i = 0;
+    for (; i + 3 <= size; i += 3)
+    {
+        uint32_t value = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        *output++ = symbols[value >> 18];
+        *output++ = symbols[(value >> 12) & 63];
+        *output++ = symbols[(value >> 6) & 63];
+        *output++ = symbols[value & 63];
+    }
+    if (i < size)
+    {
+        uint32_t value = uint32_t(data[i]) << 16;
+        if (i + 1 < size)
+            value |= uint32_t(data[i + 1]) << 8;
+        *output++ = symbols[value >> 18];
+        *output++ = symbols[(value >> 12) & 63];
+        if (i + 1 < size)
+            *output++ = symbols[(value >> 6) & 63];
+        else if (!urlSafe)
+            *output++ = '=';
+        if (!urlSafe)
+            *output = '=';
+    }
+}
+
+void rndMethods::formatUuid(const uint8_t *bytes, char *output) noexcept
+{
+    uint8_t uuid[16];
+    std::memcpy(uuid, bytes, sizeof(uuid));
+    uuid[6] = uint8_t((uuid[6] & 0x0F) | 0x40);
+    uuid[8] = uint8_t((uuid[8] & 0x3F) | 0x80);
+
+    char digits[32];
+    encodeHex(uuid, sizeof(uuid), digits);
+    std::memcpy(output, digits, 8);
+    output[8] = '-';
+    std::memcpy(output + 9, digits + 8, 4);
+    output[13] = '-';
+    std::memcpy(output + 14, digits + 12, 4);
+    output[18] = '-';
+    std::memcpy(output + 19, digits + 16, 4);
+    output[23] = '-';
+    std::memcpy(output + 24, digits + 20, 12);
+}
@@ -0,0 +1,399 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef EXPLORATIONS_WORKLOAD_H
+#define EXPLORATIONS_WORKLOAD_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <RndMethods.h>
+
+
+namespace rndMethods
+{
+    /*!
+     * @class Alphabet
+     * Set of symbols for random strings. Symbol is chosen by 16 random bits without bias: chunks falling into
+     * the biased zone of multiply-shift mapping are rejected
+     */
+    class Alphabet
+    {
+        std::string _symbols;
+        uint32_t _threshold;
+
+    public:
+        /*!
+         * @param symbols Symbols of alphabet, from 1 to 256
+         */
+        explicit Alphabet(std::string symbols);
+
+        const std::string &symbols() const noexcept { return _symbols; }
+
+        size_t size() const noexcept { return _symbols.size(); }
+
+        /*!
+         * Map 16 random bits to symbol
+         * @param chunk Random bits
+         * @param symbol Chosen symbol
+         * @return false if chunk is rejected
+         */
+        bool map(uint16_t chunk, char &symbol) const noexcept
+        {
+            uint32_t product = uint32_t(chunk) * uint32_t(_symbols.size());
+            symbol = _symbols[product >> 16];
+            return uint16_t(product) >= _threshold;
+        }
+
+        static const Alphabet &lowercase();
+
+        static const Alphabet &alphanumeric();
+
+        static const Alphabet &hex();
+
+        /*!
+         * Printable ASCII symbols without space
+         */
+        static const Alphabet &printable();
+    };
+
+
+    /*!
+     * Encode bytes to lowercase hex, 4 bytes to 8 digits per step by SWAR arithmetic
+     * @param data Bytes to encode
+     * @param size Bytes count
+     * @param output Memory for 2 * size symbols
+     */
+    void encodeHex(const uint8_t *data, size_t size, char *output) noexcept;
+
+    /*!
+     * Get length of base64 encoding
+     * @param size Bytes count
+     * @param urlSafe Url safe encoding is not padded
+     */
+    constexpr size_t base64Length(size_t size, bool urlSafe) noexcept
+    {
+        return urlSafe ? (size * 4 + 2) / 3 : (size + 2) / 3 * 4;
+    }
+
+    /*!
+     * Encode bytes to base64
+     * @param data Bytes to encode
+     * @param size Bytes count
+     * @param output Memory for base64Length(size, urlSafe) symbols
+     * @param urlSafe Use '-' and '_' symbols (RFC 4648 section 5) without padding
+     */
+    void encodeBase64(const uint8_t *data, size_t size, char *output, bool urlSafe = false) noexcept;
+
+    /*!
+     * Format 16 bytes as UUID version 4: version and variant bits are set, the rest are taken from bytes
+     * @param bytes Random bytes
+     * @param output Memory for 36 symbols
+     */
+    void formatUuid(const uint8_t *bytes, char *output) noexcept;
+
+
+    /*!
+     * Type of values in random INI documents
+     */
+    enum class IniValueType
+    {
+        Integer,
+        Real,
+        Boolean,
+        String,
+        Duration,
+        IntegerList
+    };
+
+    /*!
+     * @struct IniShape
+     * Shape of random INI documents
+     */
+    struct IniShape
+    {
+        size_t groupCount = 4;
+        size_t minKeys = 1;
+        size_t maxKeys = 16;
+        std::vector<IniValueType> valueTypes = {IniValueType::Integer, IniValueType::Real, IniValueType::Boolean,
+                                                IniValueType::String, IniValueType::Duration,
+                                                IniValueType::IntegerList};
+        size_t maxStringLength = 32;
+        size_t maxListLength = 8;
+        /*!
+         * Maximum count of units in compound durations like 1H30M15S
+         */
+        size_t maxDurationComponents = 3;
+    };
+
+
+    /*!
+     * @class WorkloadGenerator
+     * Generator of synthetic test data: strings, tokens, UUIDs, durations and INI documents. Random bytes are drawn
+     * in bulk, so the cost is dominated by encoding
+     * @tparam Engine Random number engine (see BasicRandomGenerator)
+     */
+    template<typename Engine = Xoshiro256StarStarX8>
+    class WorkloadGenerator
+    {
+        BasicRandomGenerator<Engine> _generator;
+
+        static constexpr const char *durationUnits[] = {"w", "d", "H", "M", "S", "ms", "us", "ns"};
+
+    public:
+        /*!
+         * Construct generator seeded by std::random_device
+         */
+        WorkloadGenerator() = default;
+
+        /*!
+         * Construct generator with fixed seed. Generated data is reproducible
+         */
+        explicit WorkloadGenerator(uint64_t seed) : _generator(seed) {}
+
+        BasicRandomGenerator<Engine> &generator() noexcept { return _generator; }
+
+        /*!
+         * Fill output with random symbols of alphabet
+         * @param alphabet Symbols
+         * @param output Memory for length symbols
+         * @param length Count of symbols
+         */
+        void fillString(const Alphabet &alphabet, char *output, size_t length);
+
+        std::string string(const Alphabet &alphabet, size_t length);
+
+        /*!
+         * Generate string with random length
+         * @param lengthDistribution Distribution of lengths, e.g. UniformIntDistribution<size_t> or ZipfDistribution
+         */
+        template<typename LengthDistribution>
+        std::string string(const Alphabet &alphabet, LengthDistribution &lengthDistribution);
+
+        template<typename LengthDistribution>
+        std::vector<std::string> strings(size_t count, const Alphabet &alphabet,
+                                         LengthDistribution &lengthDistribution);
+
+        /*!
+         * Generate random UUID version 4 in canonical form: 8-4-4-4-12 lowercase hex digits
+         */
+        std::string uuid();
+
+        std::vector<std::string> uuids(size_t count);
+
+        /*!
+         * Generate hex encoded token
+         * @param bytes Count of random bytes in token
+         */
+        std::string hexToken(size_t bytes);
+
+        /*!
+         * Generate base64 encoded token
+         * @param bytes Count of random bytes in token
+         * @param urlSafe Use url safe alphabet without padding
+         */
+        std::string base64Token(size_t bytes, bool urlSafe = false);
+
+        /*!
+         * Generate duration in TimeConverter syntax: from 1 to maxComponents distinct units from the largest to
+         * the smallest with values from 1 to 99, e.g. 2d12H or 1M30S250ms
+         */
+        std::string duration(size_t maxComponents = 3);
+
+        /*!
+         * Generate INI document with unique group names and unique keys in each group
+         */
+        std::string iniDocument(const IniShape &shape = IniShape());
+    };
+}
+
+
+template<typename Engine>
+void rndMethods::WorkloadGenerator<Engine>::fillString(const Alphabet &alphabet, char *output, size_t length)
+{
+    uint16_t chunks[128];
+    size_t produced = 0;
+    while (produced < length)
+    {
+        size_t count = std::min(length - produced + (length - produced) / 8 + 3, std::size(chunks)) & ~size_t(3);
+        _generator.randomData(chunks, count);
+        for (size_t i = 0; i < count && produced < length; ++i)
+        {
+            if (alphabet.map(chunks[i], output[produced]))
+                ++produced;
+        }
+    }
+}
+
+template<typename Engine>
+std::string rndMethods::WorkloadGenerator<Engine>::string(const Alphabet &alphabet, size_t length)
+{
+    std::string result(length, '\0');
+    fillString(alphabet, result.data(), length);
+    return result;
+}
+
+template<typename Engine>
+template<typename LengthDistribution>
+std::string rndMethods::WorkloadGenerator<Engine>::string(const Alphabet &alphabet,
+                                                          LengthDistribution &lengthDistribution)
+{
+    return string(alphabet, size_t(_generator.randomValue(lengthDistribution)));
+}
+
+template<typename Engine>
+template<typename LengthDistribution>
+std::vector<std::string> rndMethods::WorkloadGenerator<Engine>::strings(size_t count, const Alphabet &alphabet,
+                                                                        LengthDistribution &lengthDistribution)
+{
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        result.push_back(string(alphabet, lengthDistribution));
+    return result;
+}
+
+template<typename Engine>
+std::string rndMethods::WorkloadGenerator<Engine>::uuid()
+{
+    uint8_t bytes[16];
+    _generator.randomData(bytes, sizeof(bytes));
+    std::string result(36, '\0');
+    formatUuid(bytes, result.data());
+    return result;
+}
+
+template<typename Engine>
+std::vector<std::string> rndMethods::WorkloadGenerator<Engine>::uuids(size_t count)
+{
+    std::vector<uint8_t> bytes(count * 16);
+    _generator.randomData(bytes.data(), bytes.size());
+    std::vector<std::string> result(count, std::string(36, '\0'));
+    for (size_t i = 0; i < count; ++i)
+        formatUuid(bytes.data() + i * 16, result[i].data());
+    return result;
+}
+
+template<typename Engine>
+std::string rndMethods::WorkloadGenerator<Engine>::hexToken(size_t bytes)
+{
+    std::vector<uint8_t> data(bytes);
+    _generator.randomData(data.data(), bytes);
+    std::string result(bytes * 2, '\0');
+    encodeHex(data.data(), bytes, result.data());
+    return result;
+}
+
+template<typename Engine>
+std::string rndMethods::WorkloadGenerator<Engine>::base64Token(size_t bytes, bool urlSafe)
+{
+    std::vector<uint8_t> data(bytes);
+    _generator.randomData(data.data(), bytes);
+    std::string result(base64Length(bytes, urlSafe), '\0');
+    encodeBase64(data.data(), bytes, result.data(), urlSafe);
+    return result;
+}
+
+template<typename Engine>
+std::string rndMethods::WorkloadGenerator<Engine>::duration(size_t maxComponents)
+{
+    constexpr size_t unitCount = std::size(durationUnits);
+    maxComponents = std::clamp<size_t>(maxComponents, 1, unitCount);
+    size_t components = 1 + boundedValue(_generator.engine(), maxComponents);
+
+    std::string result;
+    size_t unit = 0;
+    for (size_t left = components; left > 0; --left)
+    {
+        unit += boundedValue(_generator.engine(), unitCount - unit - left + 1);
+        result += std::to_string(1 + boundedValue(_generator.engine(), 99));
+        result += durationUnits[unit++];
+    }
+    return result;
+}
+
+template<typename Engine>
+std::string rndMethods::WorkloadGenerator<Engine>::iniDocument(const IniShape &shape)
+{
+    UniformIntDistribution<int64_t> integers(std::numeric_limits<int64_t>::min());
+    UniformRealDistribution<double> reals(-1e6, 1e6);
+    UniformIntDistribution<size_t> keyCounts(shape.minKeys, std::max(shape.minKeys, shape.maxKeys));
+    UniformIntDistribution<size_t> nameLengths(3, 12);
+    UniformIntDistribution<size_t> stringLengths(1, std::max<size_t>(shape.maxStringLength, 1));
+    UniformIntDistribution<size_t> listLengths(1, std::max<size_t>(shape.maxListLength, 1));
+    UniformIntDistribution<size_t> types(0, shape.valueTypes.empty() ? 0 : shape.valueTypes.size() - 1);
+
+    std::string result;
+    for (size_t group = 0; group < shape.groupCount; ++group)
+    {
+        result += '[';
+        result += string(Alphabet::alphanumeric(), nameLengths);
+        result += '_';
+        result += std::to_string(group);
+        result += "]\n";
+
+        size_t keyCount = _generator.randomValue(keyCounts);
+        for (size_t key = 0; key < keyCount; ++key)
+        {
+            result += string(Alphabet::lowercase(), nameLengths);
+            result += '_';
+            result += std::to_string(key);
+            result += '=';
+
+            auto type = shape.valueTypes.empty() ? IniValueType::Integer :
+                        shape.valueTypes[_generator.randomValue(types)];
+            switch (type)
+            {
+                case IniValueType::Integer:
+                    result += std::to_string(_generator.randomValue(integers));
+                    break;
+                case IniValueType::Real:
+                {
+                    char buffer[32];
+                    int length = std::snprintf(buffer, sizeof(buffer), "%.17g", _generator.randomValue(reals));
+                    result.append(buffer, size_t(length));
+                    break;
+                }
+                case IniValueType::Boolean:
+                    result += _generator.engine()() & 1 ? "true" : "false";
+                    break;
+                case IniValueType::String:
+                    result += string(Alphabet::alphanumeric(), stringLengths);
+                    break;
+                case IniValueType::Duration:
+                    result += duration(shape.maxDurationComponents);
+                    break;
+                case IniValueType::IntegerList:
+                {
+                    size_t length = _generator.randomValue(listLengths);
+                    for (size_t i = 0; i < length; ++i)
+                    {
+                        result += std::to_string(_generator.randomValue(integers));
+                        result += ';';
+                    }
+                    break;
+                }
+            }
+            result += '\n';
+        }
+        result += '\n';
+    }
+    return result;
+}
+
+#endif //EXPLORATIONS_WORKLOAD_H
@@ -15,8 +15,20 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include <RndMethods.h>
+#include <Workload.h>
+#include <Sampling.h>
+#include <TimeConversion.h>
 #include <TestsPreparations.h>
 #include <iostream>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cmath>
+#include <set>
+#include <sstream>
+#include <map>
+#include <numeric>
+#include <iterator>
 
 #define REPEAT_COUNT 1000
 
@@ -71,5 +83,778 @@ TEST_CASE("RndMethods")
                 REQUIRE(std::is_same_v<std::remove_reference<decltype(*data.get())>::type, uint16_t>);
             }
         }
+
+        SECTION("FillUnalignedDataChunk")
+        {
+            std::vector<uint8_t> buffer(80);
+            for (size_t offset = 0; offset < 8; ++offset)
+            {
+                for (size_t dataSize = 0; dataSize <= 64; ++dataSize)
+                {
+                    std::fill(buffer.begin(), buffer.end(), 0xA5);
+                    REQUIRE_NOTHROW(RANDOM_DATA(buffer.data() + offset, dataSize));
+                    for (size_t i = 0; i < offset; ++i)
+                        REQUIRE(buffer[i] == 0xA5);
+                    for (size_t i = offset + dataSize; i < buffer.size(); ++i)
+                        REQUIRE(buffer[i] == 0xA5);
+                }
+            }
+
+            std::vector<uint64_t> large(1 << 16);
+            RANDOM_DATA(large.data(), large.size());
+            REQUIRE(std::count(large.begin(), large.end(), 0) < 4);
+        }
+    }
+
+    SECTION("Engines")
+    {
+        SECTION("ReferenceOutputs")
+        {
+            rndMethods::SplitMix64 splitMix(1234567);
+            for (uint64_t expected: {6457827717110365317ull, 3203168211198807973ull, 9817491932198370423ull,
+                                     4593380528125082431ull, 16408922859458223821ull})
+                REQUIRE(splitMix() == expected);
+
+            rndMethods::Xoshiro256StarStar xoshiro(1, 2, 3, 4);
+            for (uint64_t expected: {11520ull, 0ull, 1509978240ull, 1215971899390074240ull, 1216172134540287360ull,
+                                     607988272756665600ull, 16172922978634559625ull, 8476171486693032832ull,
+                                     10595114339597558777ull, 2904607092377533576ull})
+                REQUIRE(xoshiro() == expected);
+        }
+
+        SECTION("Jump")
+        {
+            rndMethods::Xoshiro256StarStar first(42), second(42);
+            first.jump();
+            REQUIRE(first != second);
+            second.jump();
+            REQUIRE(first == second);
+            second.longJump();
+            REQUIRE(first != second);
+        }
+
+        SECTION("Reproducible")
+        {
+            auto checkEngine = [](auto *engineTag)
+            {
+                typedef rndMethods::BasicRandomGenerator<std::remove_pointer_t<decltype(engineTag)>> Generator;
+                Generator first(REPEAT_COUNT), second(REPEAT_COUNT), other(REPEAT_COUNT + 1);
+                auto firstData = first.template randomData<uint32_t>(REPEAT_COUNT);
+                REQUIRE(firstData == second.template randomData<uint32_t>(REPEAT_COUNT));
+                REQUIRE(firstData != other.template randomData<uint32_t>(REPEAT_COUNT));
+                REQUIRE(first.template randomValue<uint16_t>() == second.template randomValue<uint16_t>());
+                REQUIRE(std::count(firstData.begin(), firstData.end(), 0u) < 2);
+            };
+            checkEngine(static_cast<std::mt19937 *>(nullptr));
+            checkEngine(static_cast<std::minstd_rand *>(nullptr));
+            checkEngine(static_cast<rndMethods::SplitMix64 *>(nullptr));
+            checkEngine(static_cast<rndMethods::Xoshiro256StarStar *>(nullptr));
+            checkEngine(static_cast<rndMethods::Pcg64 *>(nullptr));
+            checkEngine(static_cast<rndMethods::WyRand *>(nullptr));
+            checkEngine(static_cast<rndMethods::Xoshiro256StarStarX8 *>(nullptr));
+            checkEngine(static_cast<rndMethods::Philox4x32 *>(nullptr));
+            checkEngine(static_cast<rndMethods::PooledEngine<> *>(nullptr));
+            checkEngine(static_cast<rndMethods::PooledEngine<rndMethods::WyRand, 7> *>(nullptr));
+        }
+
+        SECTION("MultiLane")
+        {
+            typedef rndMethods::Xoshiro256StarStarX8 EngineX8;
+            rndMethods::Xoshiro256StarStar lane0(REPEAT_COUNT);
+            rndMethods::Xoshiro256StarStar lane1(REPEAT_COUNT);
+            lane1.jump();
+            EngineX8 engine(REPEAT_COUNT);
+            for (int step = 0; step < 4; ++step)
+            {
+                REQUIRE(engine() == lane0());
+                REQUIRE(engine() == lane1());
+                for (size_t lane = 2; lane < EngineX8::lanes; ++lane)
+                    engine();
+            }
+
+            std::vector<uint8_t> reference(4099);
+            EngineX8 scalar(REPEAT_COUNT);
+            scalar.setIsa(EngineX8::Isa::Scalar);
+            REQUIRE(scalar.isa() == EngineX8::Isa::Scalar);
+            for (size_t offset = 0; offset < reference.size(); offset += 8)
+            {
+                uint64_t word = scalar();
+                std::memcpy(reference.data() + offset, &word, std::min<size_t>(8, reference.size() - offset));
+            }
+
+            for (auto isa: {EngineX8::Isa::Scalar, EngineX8::Isa::Avx2, EngineX8::Isa::Avx512})
+            {
+                for (size_t chunk: {size_t(8), size_t(24), size_t(64), size_t(1000), reference.size()})
+                {
+                    INFO("Isa " << int(isa) << ", chunk " << chunk);
+                    EngineX8 vector(REPEAT_COUNT);
+                    vector.setIsa(isa);
+                    std::vector<uint8_t> data(reference.size() + 1, 0xA5);
+                    for (size_t offset = 0; offset < reference.size(); offset += chunk)
+                        vector.fill(data.data() + offset + 1, std::min(chunk, reference.size() - offset));
+                    REQUIRE(data[0] == 0xA5);
+                    REQUIRE(std::equal(reference.begin(), reference.end(), data.begin() + 1));
+                }
+            }
+
+            EngineX8 partial(REPEAT_COUNT);
+            uint8_t head[5];
+            partial.fill(head, sizeof(head));
+            REQUIRE(std::equal(head, head + sizeof(head), reference.begin()));
+            uint64_t second = partial();
+            REQUIRE(std::memcmp(&second, reference.data() + 8, sizeof(second)) == 0);
+        }
+
+        SECTION("CounterBased")
+        {
+            typedef rndMethods::Philox4x32 Philox;
+            REQUIRE(Philox::block({0, 0, 0, 0}, {0, 0}) ==
+                    Philox::Block{0x6627E8D5u, 0xE169C58Du, 0xBC57AC4Cu, 0x9B00DBD8u});
+            REQUIRE(Philox::block({0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu}, {0xFFFFFFFFu, 0xFFFFFFFFu}) ==
+                    Philox::Block{0x408F276Du, 0x41C83B0Eu, 0xA20BC7C6u, 0x6D5451FDu});
+            REQUIRE(Philox::block({0x243F6A88u, 0x85A308D3u, 0x13198A2Eu, 0x03707344u}, {0xA4093822u, 0x299F31D0u}) ==
+                    Philox::Block{0xD16CFE09u, 0x94FDCCEBu, 0x5001E420u, 0x24126EA1u});
+
+            Philox sequential(REPEAT_COUNT, 3);
+            std::vector<uint64_t> reference(REPEAT_COUNT);
+            for (auto &word: reference)
+                word = sequential();
+            REQUIRE(sequential.position() == REPEAT_COUNT);
+
+            Philox random(REPEAT_COUNT, 3);
+            for (uint64_t index: {uint64_t(0), uint64_t(1), uint64_t(REPEAT_COUNT - 1), uint64_t(REPEAT_COUNT / 2)})
+                REQUIRE(random.at(index) == reference[index]);
+            random.seek(REPEAT_COUNT / 3);
+            REQUIRE(random() == reference[REPEAT_COUNT / 3]);
+            random.discard(4);
+            REQUIRE(random() == reference[REPEAT_COUNT / 3 + 5]);
+
+            for (auto range: {std::pair<uint64_t, uint64_t>(0, 0), {0, 1}, {1, 2}, {1, 8}, {3, 10}, {4, 20},
+                              {0, REPEAT_COUNT}})
+            {
+                INFO("Range " << range.first << " " << range.second);
+                std::vector<uint64_t> words(range.second - range.first + 1, 0);
+                random.fill(range.first, range.second, words.data());
+                REQUIRE(std::equal(words.begin(), words.end() - 1, reference.begin() + range.first));
+                REQUIRE(words.back() == 0);
+            }
+
+            std::vector<uint8_t> bytes(8 * 200 + 3);
+            Philox byteFill(REPEAT_COUNT, 3);
+            byteFill.fill(bytes.data(), 5);
+            byteFill.fill(bytes.data() + 8, bytes.size() - 8);
+            REQUIRE(byteFill.position() == 201);
+            REQUIRE(std::memcmp(bytes.data(), reference.data(), 5) == 0);
+            REQUIRE(std::memcmp(bytes.data() + 8, reference.data() + 1, bytes.size() - 8) == 0);
+
+            Philox otherStream = sequential.stream(4);
+            REQUIRE(otherStream.streamNumber() == 4);
+            REQUIRE(otherStream.position() == 0);
+            REQUIRE(otherStream() != reference[0]);
+            Philox sameStream(REPEAT_COUNT, 4);
+            sameStream();
+            REQUIRE(otherStream == sameStream);
+            static_assert(Philox(1).at(5) == Philox(1).stream(0).at(5));
+        }
+
+        SECTION("Pooled")
+        {
+            auto checkPool = [](auto *engineTag)
+            {
+                typedef std::remove_pointer_t<decltype(engineTag)> Engine;
+                typedef typename Engine::engine_type Underlying;
+                Underlying underlying(REPEAT_COUNT);
+                std::vector<uint8_t> reference(Engine::poolSize * 8 * 5 + 13);
+                for (size_t offset = 0; offset < reference.size(); offset += 8)
+                {
+                    uint64_t word = underlying();
+                    std::memcpy(reference.data() + offset, &word, std::min<size_t>(8, reference.size() - offset));
+                }
+
+                Engine pooled(REPEAT_COUNT);
+                REQUIRE(pooled.available() == 0);
+                std::vector<uint8_t> data(reference.size());
+                size_t offset = 0;
+                auto skipTruncated = [&offset, &reference]
+                {
+                    size_t next = (offset + 7) / 8 * 8;
+                    std::fill(reference.begin() + offset, reference.begin() + next, 0);
+                    offset = next;
+                };
+                for (size_t chunk: {size_t(8), size_t(3), Engine::poolSize * 8 * 3 + 5})
+                {
+                    skipTruncated();
+                    pooled.fill(data.data() + offset, chunk);
+                    offset += chunk;
+                }
+                skipTruncated();
+                for (; offset < data.size(); offset += 8)
+                {
+                    uint64_t word = pooled();
+                    std::memcpy(data.data() + offset, &word, std::min<size_t>(8, data.size() - offset));
+                }
+                REQUIRE(data == reference);
+            };
+            checkPool(static_cast<rndMethods::PooledEngine<> *>(nullptr));
+            checkPool(static_cast<rndMethods::PooledEngine<rndMethods::Xoshiro256StarStar, 64> *>(nullptr));
+            checkPool(static_cast<rndMethods::PooledEngine<rndMethods::WyRand, 1> *>(nullptr));
+
+            auto &generator = rndMethods::threadPooledRandomGenerator();
+            REQUIRE(reinterpret_cast<uintptr_t>(&generator) % 64 == 0);
+            uint64_t mainValue = generator.randomValue<uint64_t>();
+            uint64_t threadValue = 0;
+            std::thread([&threadValue]
+                        {
+                            threadValue = rndMethods::threadPooledRandomGenerator().randomValue<uint64_t>();
+                        }).join();
+            REQUIRE(mainValue != threadValue);
+        }
+    }
+
+    SECTION("ThreadLocal")
+    {
+        REQUIRE(&rndMethods::threadRandomGenerator() == &rndMethods::threadRandomGenerator());
+
+        constexpr size_t threadCount = 16;
+        std::vector<std::vector<uint64_t>> values(threadCount);
+        std::vector<const void *> generators(threadCount);
+        std::vector<std::thread> threads;
+        std::atomic<size_t> running(0);
+        for (size_t thread = 0; thread < threadCount; ++thread)
+        {
+            threads.emplace_back([&values, &generators, &running, thread]()
+            {
+                generators[thread] = &rndMethods::threadRandomGenerator();
+                values[thread] = RANDOM_DATA<uint64_t>(REPEAT_COUNT);
+                ++running;
+                while (running < threadCount)
+                    std::this_thread::yield();
+            });
+        }
+        for (auto &thread: threads)
+            thread.join();
+
+        std::vector<uint64_t> allValues;
+        for (auto &threadValues: values)
+            allValues.insert(allValues.end(), threadValues.begin(), threadValues.end());
+        std::sort(allValues.begin(), allValues.end());
+        REQUIRE(std::adjacent_find(allValues.begin(), allValues.end()) == allValues.end());
+        std::sort(generators.begin(), generators.end());
+        REQUIRE(std::adjacent_find(generators.begin(), generators.end()) == generators.end());
+    }
+
+    SECTION("ParallelFill")
+    {
+        constexpr size_t dataSize = rndMethods::parallelBlockSize * 5 + 12345;
+        std::vector<uint8_t> reference(dataSize);
+        RANDOM_DATA(reference.data(), reference.size(), REPEAT_COUNT, 1);
+        REQUIRE(size_t(std::count(reference.begin(), reference.end(), 0)) < dataSize / 128);
+
+        std::vector<uint8_t> data(dataSize);
+        for (size_t threadCount: {size_t(0), size_t(2), size_t(3), size_t(7), size_t(64)})
+        {
+            INFO("Threads " << threadCount);
+            std::fill(data.begin(), data.end(), 0);
+            RANDOM_DATA(data.data(), data.size(), REPEAT_COUNT, threadCount);
+            REQUIRE(data == reference);
+        }
+
+        std::vector<uint64_t> words(dataSize / 8);
+        rndMethods::BasicRandomGenerator<rndMethods::WyRand>::randomData(words.data(), words.size(), REPEAT_COUNT);
+        REQUIRE(std::memcmp(words.data(), reference.data(), words.size() * 8) == 0);
+
+        rndMethods::Xoshiro256StarStar blockEngine(REPEAT_COUNT);
+        blockEngine.longJump();
+        rndMethods::Xoshiro256StarStarX8 secondBlock(blockEngine);
+        uint64_t word = secondBlock();
+        REQUIRE(std::memcmp(&word, reference.data() + rndMethods::parallelBlockSize, sizeof(word)) == 0);
+
+        RANDOM_DATA(data.data(), data.size(), REPEAT_COUNT + 1, 4);
+        REQUIRE(data != reference);
+        REQUIRE_NOTHROW(RANDOM_DATA(data.data(), 0, REPEAT_COUNT, 4));
+    }
+
+    SECTION("Distributions")
+    {
+        constexpr size_t sampleCount = 200000;
+        rndMethods::BasicRandomGenerator<rndMethods::Xoshiro256StarStar> generator(REPEAT_COUNT);
+        auto meanAndDeviation = [](const auto &values)
+        {
+            double sum = 0, squares = 0;
+            for (auto value: values)
+            {
+                sum += double(value);
+                squares += double(value) * double(value);
+            }
+            double mean = sum / double(values.size());
+            return std::make_pair(mean, std::sqrt(squares / double(values.size()) - mean * mean));
+        };
+
+        SECTION("UniformInt")
+        {
+            rndMethods::UniformIntDistribution<int> dice(-3, 3);
+            std::vector<size_t> counts(7, 0);
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                int value = generator.randomValue(dice);
+                REQUIRE(value >= -3);
+                REQUIRE(value <= 3);
+                ++counts[size_t(value + 3)];
+            }
+            for (size_t count: counts)
+                REQUIRE(std::abs(double(count) - sampleCount / 7.0) < sampleCount / 100.0);
+
+            rndMethods::UniformIntDistribution<uint64_t> full;
+            REQUIRE(full.max() == std::numeric_limits<uint64_t>::max());
+            rndMethods::UniformIntDistribution<int64_t> signedFull(std::numeric_limits<int64_t>::min());
+            REQUIRE(signedFull.max() == std::numeric_limits<int64_t>::max());
+            REQUIRE(generator.randomValue(full) != generator.randomValue(full));
+            rndMethods::UniformIntDistribution<uint8_t> single(42, 42);
+            REQUIRE(generator.randomValue(single) == 42);
+
+            rndMethods::Xoshiro256StarStar first(REPEAT_COUNT), second(REPEAT_COUNT), third(REPEAT_COUNT);
+            rndMethods::UniformIntDistribution<uint32_t> bounded(0, 999999);
+            std::vector<uint32_t> batch(REPEAT_COUNT);
+            bounded.fill(first, batch.data(), batch.size());
+            for (auto value: batch)
+            {
+                REQUIRE(value == bounded(second));
+                REQUIRE(value == rndMethods::boundedValue(third, 1000000));
+            }
+        }
+
+        SECTION("UniformReal")
+        {
+            rndMethods::UniformRealDistribution<double> unit;
+            rndMethods::UniformRealDistribution<float> range(-2.0f, 6.0f);
+            std::vector<double> units(sampleCount);
+            std::vector<float> ranges(sampleCount);
+            generator.randomData(unit, units.data(), units.size());
+            generator.randomData(range, ranges.data(), ranges.size());
+            REQUIRE(*std::min_element(units.begin(), units.end()) >= 0.0);
+            REQUIRE(*std::max_element(units.begin(), units.end()) < 1.0);
+            REQUIRE(*std::min_element(ranges.begin(), ranges.end()) >= -2.0f);
+            REQUIRE(*std::max_element(ranges.begin(), ranges.end()) < 6.0f);
+            REQUIRE(std::abs(meanAndDeviation(units).first - 0.5) < 0.01);
+            REQUIRE(std::abs(meanAndDeviation(ranges).first - 2.0) < 0.05);
+            REQUIRE(rndMethods::unitDouble(0) == 0.0);
+            REQUIRE(rndMethods::unitDouble(~uint64_t(0)) == 1.0 - 0x1.0p-52);
+            REQUIRE(rndMethods::unitFloat(~uint64_t(0)) == 1.0f - 0x1.0p-23f);
+        }
+
+        SECTION("Normal")
+        {
+            rndMethods::NormalDistribution<double> normal(10.0, 2.0);
+            std::vector<double> values(sampleCount);
+            generator.randomData(normal, values.data(), values.size());
+            auto [mean, deviation] = meanAndDeviation(values);
+            REQUIRE(std::abs(mean - 10.0) < 0.03);
+            REQUIRE(std::abs(deviation - 2.0) < 0.03);
+            auto inSigma = std::count_if(values.begin(), values.end(),
+                                         [](double value) { return std::abs(value - 10.0) < 2.0; });
+            REQUIRE(std::abs(double(inSigma) / sampleCount - 0.6827) < 0.005);
+            auto tail = std::count_if(values.begin(), values.end(),
+                                      [](double value) { return std::abs(value - 10.0) > 2.0 * 3.5; });
+            REQUIRE(tail > 0);
+            REQUIRE(tail < 200);
+
+            rndMethods::Xoshiro256StarStar first(REPEAT_COUNT), second(REPEAT_COUNT);
+            std::vector<float> batch(REPEAT_COUNT);
+            rndMethods::NormalDistribution<float> standard;
+            standard.fill(first, batch.data(), batch.size());
+            for (auto value: batch)
+                REQUIRE(value == standard(second));
+        }
+
+        SECTION("Exponential")
+        {
+            rndMethods::ExponentialDistribution<double> exponential(4.0);
+            std::vector<double> values(sampleCount);
+            generator.randomData(exponential, values.data(), values.size());
+            REQUIRE(*std::min_element(values.begin(), values.end()) >= 0.0);
+            auto [mean, deviation] = meanAndDeviation(values);
+            REQUIRE(std::abs(mean - 0.25) < 0.005);
+            REQUIRE(std::abs(deviation - 0.25) < 0.005);
+            auto belowMean = std::count_if(values.begin(), values.end(), [](double value) { return value < 0.25; });
+            REQUIRE(std::abs(double(belowMean) / sampleCount - (1 - std::exp(-1.0))) < 0.005);
+        }
+
+        SECTION("Zipf")
+        {
+            for (double exponent: {0.5, 1.0, 1.5})
+            {
+                INFO("Exponent " << exponent);
+                rndMethods::ZipfDistribution<uint32_t> zipf(1000, exponent);
+                std::vector<uint32_t> values(sampleCount);
+                generator.randomData(zipf, values.data(), values.size());
+                REQUIRE(*std::min_element(values.begin(), values.end()) == 1);
+                REQUIRE(*std::max_element(values.begin(), values.end()) <= 1000);
+                double normalization = 0;
+                for (int k = 1; k <= 1000; ++k)
+                    normalization += std::pow(k, -exponent);
+                for (uint32_t k: {1u, 2u, 10u})
+                {
+                    double expected = std::pow(k, -exponent) / normalization;
+                    auto count = std::count(values.begin(), values.end(), k);
+                    REQUIRE(std::abs(double(count) / sampleCount - expected) < 0.1 * expected);
+                }
+            }
+            rndMethods::ZipfDistribution<uint64_t> single(1, 2.0);
+            REQUIRE(generator.randomValue(single) == 1);
+        }
+
+        SECTION("Bernoulli")
+        {
+            rndMethods::BernoulliDistribution never(0.0), always(1.0), rare(0.3);
+            std::unique_ptr<bool[]> values(new bool[sampleCount]);
+            generator.randomData(rare, values.get(), sampleCount);
+            REQUIRE(std::abs(double(std::count(values.get(), values.get() + sampleCount, true)) / sampleCount - 0.3) <
+                    0.005);
+            for (int i = 0; i < REPEAT_COUNT; ++i)
+            {
+                REQUIRE_FALSE(generator.randomValue(never));
+                REQUIRE(generator.randomValue(always));
+            }
+        }
+    }
+
+    SECTION("Workload")
+    {
+        typedef timeConversion::TimeConverter Converter;
+        rndMethods::WorkloadGenerator<> workload(REPEAT_COUNT);
+
+        SECTION("Strings")
+        {
+            auto hexString = workload.string(rndMethods::Alphabet::hex(), REPEAT_COUNT);
+            REQUIRE(hexString.size() == REPEAT_COUNT);
+            REQUIRE(hexString.find_first_not_of("0123456789abcdef") == std::string::npos);
+            REQUIRE(std::set<char>(hexString.begin(), hexString.end()).size() == 16);
+
+            rndMethods::Alphabet abc("abc");
+            auto abcString = workload.string(abc, 30000);
+            for (char symbol: abc.symbols())
+                REQUIRE(std::abs(double(std::count(abcString.begin(), abcString.end(), symbol)) - 10000.0) < 500);
+            REQUIRE_THROWS_AS(rndMethods::Alphabet(""), std::invalid_argument);
+            REQUIRE(workload.string(rndMethods::Alphabet::printable(), 0).empty());
+            REQUIRE(rndMethods::Alphabet::printable().size() == 94);
+
+            rndMethods::UniformIntDistribution<size_t> lengths(5, 10);
+            auto strings = workload.strings(REPEAT_COUNT, rndMethods::Alphabet::alphanumeric(), lengths);
+            REQUIRE(strings.size() == REPEAT_COUNT);
+            for (auto &string: strings)
+            {
+                REQUIRE(string.size() >= 5);
+                REQUIRE(string.size() <= 10);
+                REQUIRE(std::all_of(string.begin(), string.end(), [](char symbol) { return std::isalnum(symbol); }));
+            }
+        }
+
+        SECTION("Encodings")
+        {
+            const uint8_t bytes[] = {0x01, 0x23, 0xAB, 0xFF, 0x00, 0x9A, 0x5C};
+            char hex[14];
+            rndMethods::encodeHex(bytes, sizeof(bytes), hex);
+            REQUIRE(std::string(hex, sizeof(hex)) == "0123abff009a5c");
+
+            auto data = RANDOM_DATA<uint8_t>(REPEAT_COUNT);
+            std::string encoded(data.size() * 2, '\0');
+            rndMethods::encodeHex(data.data(), data.size(), encoded.data());
+            std::string expected;
+            for (auto byte: data)
+            {
+                char digits[3];
+                std::snprintf(digits, sizeof(digits), "%02x", byte);
+                expected += digits;
+            }
+            REQUIRE(encoded == expected);
+
+            auto base64 = [](const std::string &text, bool urlSafe)
+            {
+                std::string result(rndMethods::base64Length(text.size(), urlSafe), '\0');
+                rndMethods::encodeBase64(reinterpret_cast<const uint8_t *>(text.data()), text.size(), result.data(),
+                                         urlSafe);
+                return result;
+            };
+            REQUIRE(base64("", false).empty());
+            REQUIRE(base64("f", false) == "Zg==");
+            REQUIRE(base64("fo", false) == "Zm8=");
+            REQUIRE(base64("foo", false) == "Zm9v");
+            REQUIRE(base64("foob", false) == "Zm9vYg==");
+            REQUIRE(base64("fooba", false) == "Zm9vYmE=");
+            REQUIRE(base64("foobar", false) == "Zm9vYmFy");
+            REQUIRE(base64("f", true) == "Zg");
+            REQUIRE(base64("fo", true) == "Zm8");
+            REQUIRE(base64("\xFB\xFF", false) == "+/8=");
+            REQUIRE(base64("\xFB\xFF", true) == "-_8");
+        }
+
+        SECTION("Tokens")
+        {
+            auto uuids = workload.uuids(REPEAT_COUNT);
+            uuids.push_back(workload.uuid());
+            for (auto &uuid: uuids)
+            {
+                REQUIRE(uuid.size() == 36);
+                REQUIRE(uuid[8] == '-');
+                REQUIRE(uuid[13] == '-');
+                REQUIRE(uuid[18] == '-');
+                REQUIRE(uuid[23] == '-');
+                REQUIRE(uuid[14] == '4');
+                REQUIRE(std::string("89ab").find(uuid[19]) != std::string::npos);
+                REQUIRE(uuid.find_first_not_of("0123456789abcdef-") == std::string::npos);
+            }
+            REQUIRE(std::set<std::string>(uuids.begin(), uuids.end()).size() == uuids.size());
+
+            auto hexToken = workload.hexToken(17);
+            REQUIRE(hexToken.size() == 34);
+            REQUIRE(hexToken.find_first_not_of("0123456789abcdef") == std::string::npos);
+            REQUIRE(workload.base64Token(16).size() == 24);
+            REQUIRE(workload.base64Token(16, true).size() == 22);
+        }
+
+        SECTION("Durations")
+        {
+            for (size_t components: {size_t(0), size_t(1), size_t(3), size_t(8), size_t(20)})
+            {
+                for (int i = 0; i < REPEAT_COUNT; ++i)
+                {
+                    auto duration = workload.duration(components);
+                    INFO("Duration " << duration);
+                    REQUIRE(Converter::tryStringToTime<Converter::nanoseconds>(duration).second == Parse::Success);
+                    auto units = std::count_if(duration.begin(), duration.end(), [](char symbol)
+                    {
+                        return std::isdigit(symbol) == 0;
+                    });
+                    REQUIRE(units >= 1);
+                }
+            }
+        }
+
+        SECTION("IniDocument")
+        {
+            rndMethods::IniShape shape;
+            shape.groupCount = 10;
+            shape.minKeys = 3;
+            shape.maxKeys = 20;
+            auto document = workload.iniDocument(shape);
+            REQUIRE(document == rndMethods::WorkloadGenerator<>(REPEAT_COUNT).iniDocument(shape));
+
+            std::istringstream lines(document);
+            std::string line;
+            std::set<std::string> groups, keys;
+            size_t keyCount = 0;
+            while (std::getline(lines, line))
+            {
+                if (line.empty())
+                    continue;
+                if (line.front() == '[')
+                {
+                    REQUIRE(line.back() == ']');
+                    REQUIRE(groups.insert(line).second);
+                    if (!keys.empty())
+                    {
+                        REQUIRE(keys.size() >= shape.minKeys);
+                        REQUIRE(keys.size() <= shape.maxKeys);
+                    }
+                    keyCount += keys.size();
+                    keys.clear();
+                    continue;
+                }
+                auto separator = line.find('=');
+                REQUIRE(separator != std::string::npos);
+                REQUIRE(separator + 1 < line.size());
+                REQUIRE(keys.insert(line.substr(0, separator)).second);
+            }
+            keyCount += keys.size();
+            REQUIRE(groups.size() == shape.groupCount);
+            REQUIRE(keyCount >= shape.groupCount * shape.minKeys);
+
+            shape.valueTypes = {rndMethods::IniValueType::Duration};
+            std::istringstream durations(workload.iniDocument(shape));
+            while (std::getline(durations, line))
+            {
+                if (line.empty() || line.front() == '[')
+                    continue;
+                auto value = line.substr(line.find('=') + 1);
+                INFO("Duration " << value);
+                REQUIRE(Converter::tryStringToTime<Converter::nanoseconds>(value).second == Parse::Success);
+            }
+        }
+    }
+
+    SECTION("Sampling")
+    {
+        rndMethods::Xoshiro256StarStar engine(REPEAT_COUNT);
+
+        SECTION("Shuffle")
+        {
+            std::vector<size_t> counts(15, 0);
+            for (int i = 0; i < 15 * REPEAT_COUNT; ++i)
+            {
+                auto [first, second] = rndMethods::boundedPair(engine, 3, 5);
+                REQUIRE(first < 3);
+                REQUIRE(second < 5);
+                ++counts[first * 5 + second];
+            }
+            for (size_t count: counts)
+                REQUIRE(std::abs(double(count) - REPEAT_COUNT) < 150);
+
+            std::map<std::vector<int>, size_t> permutations;
+            for (int i = 0; i < 24 * REPEAT_COUNT; ++i)
+            {
+                std::vector<int> values = {0, 1, 2, 3};
+                rndMethods::shuffle(values.begin(), values.end(), engine);
+                ++permutations[values];
+            }
+            REQUIRE(permutations.size() == 24);
+            for (auto &[permutation, count]: permutations)
+                REQUIRE(std::abs(double(count) - REPEAT_COUNT) < 150);
+
+            std::vector<int> values(REPEAT_COUNT), copy;
+            std::iota(values.begin(), values.end(), 0);
+            copy = values;
+            rndMethods::Xoshiro256StarStar first(1), second(1);
+            rndMethods::shuffle(values.begin(), values.end(), first);
+            rndMethods::shuffle(copy.begin(), copy.end(), second);
+            REQUIRE(values == copy);
+            std::sort(values.begin(), values.end());
+            REQUIRE(values[0] == 0);
+            REQUIRE(std::adjacent_find(values.begin(), values.end(), [](int left, int right)
+            {
+                return right != left + 1;
+            }) == values.end());
+            rndMethods::shuffle(values.begin(), values.begin(), engine);
+            rndMethods::shuffle(values.begin(), values.begin() + 1, engine);
+        }
+
+        SECTION("Reservoir")
+        {
+            std::vector<int> input(20), sample(5);
+            std::iota(input.begin(), input.end(), 0);
+            std::vector<size_t> counts(input.size(), 0);
+            constexpr int rounds = 20 * REPEAT_COUNT;
+            for (int i = 0; i < rounds; ++i)
+            {
+                REQUIRE(rndMethods::reservoirSample(input.begin(), input.end(), sample.begin(), sample.size(),
+                                                    engine) == sample.size());
+                REQUIRE(std::set<int>(sample.begin(), sample.end()).size() == sample.size());
+                for (int value: sample)
+                    ++counts[size_t(value)];
+            }
+            for (size_t count: counts)
+                REQUIRE(std::abs(double(count) / rounds - 0.25) < 0.015);
+
+            std::istringstream stream("1 2 3");
+            std::vector<int> large(10, -1);
+            REQUIRE(rndMethods::reservoirSample(std::istream_iterator<int>(stream), std::istream_iterator<int>(),
+                                                large.begin(), large.size(), engine) == 3);
+            REQUIRE(large[2] == 3);
+            REQUIRE(large[3] == -1);
+
+            std::istringstream longStream;
+            std::string numbers;
+            for (int i = 0; i < 100000; ++i)
+                numbers += std::to_string(i) + " ";
+            longStream.str(numbers);
+            REQUIRE(rndMethods::reservoirSample(std::istream_iterator<int>(longStream), std::istream_iterator<int>(),
+                                                sample.begin(), sample.size(), engine) == sample.size());
+            REQUIRE(std::set<int>(sample.begin(), sample.end()).size() == sample.size());
+        }
+
+        SECTION("AliasTable")
+        {
+            auto frequencies = [&engine](const rndMethods::AliasTable &table, size_t rounds)
+            {
+                std::vector<double> result(table.size(), 0);
+                for (size_t i = 0; i < rounds; ++i)
+                    ++result[table(engine)];
+                for (auto &frequency: result)
+                    frequency /= double(rounds);
+                return result;
+            };
+
+            rndMethods::AliasTable small({1, 2, 3, 4, 0});
+            REQUIRE(small.totalWeight() == 10);
+            auto smallFrequencies = frequencies(small, 100 * REPEAT_COUNT);
+            for (size_t i = 0; i < small.size(); ++i)
+                REQUIRE(std::abs(smallFrequencies[i] - small.weight(i) / 10) < 0.005);
+            REQUIRE(smallFrequencies[4] == 0);
+
+            small.setWeight(4, 10);
+            small.setWeight(0, 0);
+            smallFrequencies = frequencies(small, 100 * REPEAT_COUNT);
+            REQUIRE(smallFrequencies[0] == 0);
+            REQUIRE(std::abs(smallFrequencies[4] - 10.0 / 19) < 0.005);
+
+            std::vector<double> weights(REPEAT_COUNT * 10);
+            for (size_t i = 0; i < weights.size(); ++i)
+                weights[i] = double(i % 7);
+            rndMethods::AliasTable large(weights);
+            std::vector<std::pair<size_t, double>> updates;
+            for (size_t i = 0; i < weights.size(); i += 3)
+                updates.emplace_back(i, 0.0);
+            updates.emplace_back(weights.size() - 1, 1000.0);
+            large.setWeights(updates);
+            double total = large.totalWeight();
+            std::vector<double> groups(3, 0);
+            for (size_t i = 0; i < 300 * REPEAT_COUNT; ++i)
+            {
+                size_t index = large(engine);
+                REQUIRE(large.weight(index) > 0);
+                ++groups[index % 3];
+            }
+            double expectedFirst = 0;
+            for (size_t i = 1; i < weights.size(); i += 3)
+                expectedFirst += large.weight(i);
+            REQUIRE(std::abs(groups[1] / (300 * REPEAT_COUNT) - expectedFirst / total) < 0.005);
+            REQUIRE(std::abs(groups[0] / (300 * REPEAT_COUNT) - 1000 / total) < 0.005);
+
+            REQUIRE_THROWS_AS(rndMethods::AliasTable({}), std::invalid_argument);
+            REQUIRE_THROWS_AS(rndMethods::AliasTable({0, 0}), std::invalid_argument);
+            REQUIRE_THROWS_AS(rndMethods::AliasTable({1, -1}), std::invalid_argument);
+            REQUIRE_THROWS_AS(small.setWeight(1, NAN), std::invalid_argument);
+            REQUIRE_THROWS_AS(small.setWeight(10, 1), std::out_of_range);
+            rndMethods::AliasTable single({5});
+            REQUIRE_THROWS_AS(single.setWeight(0, 0), std::invalid_argument);
+            REQUIRE(single.weight(0) == 5);
+            REQUIRE(single(engine) == 0);
+        }
+
+        SECTION("ParallelShuffle")
+        {
+            for (size_t count: {size_t(1000), (size_t(1) << 20) + 123})
+            {
+                INFO("Count " << count);
+                std::vector<uint32_t> reference(count);
+                std::iota(reference.begin(), reference.end(), 0);
+                rndMethods::parallelShuffle(reference.data(), reference.size(), REPEAT_COUNT, 1);
+
+                std::vector<uint32_t> sorted = reference, identity(count);
+                std::sort(sorted.begin(), sorted.end());
+                std::iota(identity.begin(), identity.end(), 0);
+                REQUIRE(sorted == identity);
+                size_t fixedPoints = 0;
+                for (size_t i = 0; i < count; ++i)
+                    fixedPoints += reference[i] == i;
+                REQUIRE(fixedPoints < 10);
+
+                for (size_t threadCount: {size_t(0), size_t(3), size_t(8)})
+                {
+                    std::vector<uint32_t> values(count);
+                    std::iota(values.begin(), values.end(), 0);
+                    rndMethods::parallelShuffle(values.data(), values.size(), REPEAT_COUNT, threadCount);
+                    REQUIRE(values == reference);
+                }
+                std::vector<uint32_t> other(count);
+                std::iota(other.begin(), other.end(), 0);
+                rndMethods::parallelShuffle(other.data(), other.size(), REPEAT_COUNT + 1, 4);
+                REQUIRE(other != reference);
+            }
+
+            std::vector<std::string> strings = {"a", "b", "c"};
+            rndMethods::parallelShuffle(strings.data(), strings.size(), REPEAT_COUNT);
+            std::sort(strings.begin(), strings.end());
+            REQUIRE(strings == std::vector<std::string>{"a", "b", "c"});
+        }
     }
-}
\ No newline at end of file
+}
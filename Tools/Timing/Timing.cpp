@@ -0,0 +1,173 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <Timing.h>
+#include <thread>
+#include <cmath>
+#include <limits>
+
+#if TIMING_HAS_TSC
+#include <cpuid.h>
+#endif // TIMING_HAS_TSC
+
+bool timing::TscClock::hasInvariantTsc() noexcept
+{
+#if TIMING_HAS_TSC
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0)
+        return false;
+    return (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif // TIMING_HAS_TSC
+}
+
+timing::TscClock::Calibration timing::TscClock::calibrate() noexcept
+{
+    typedef std::chrono::steady_clock steady;
+    auto steadyNow = []()
+    {
+        return int64_t(std::chrono::duration_cast<nanoseconds>(steady::now().time_since_epoch()).count());
+    };
+
+    Calibration res = {0, steadyNow(), uint64_t(1) << 32, hasInvariantTsc()};
+    res.tscBase = uint64_t(res.steadyBase);
+#if TIMING_HAS_TSC
+    if (!res.invariantTsc)
+        return res;
+
+    // Thread can be preempted between reading of two clocks, so steady clock is read between two TSC readings
+    // and the pair read within the shortest TSC interval is taken
+    auto sample = [&steadyNow](int64_t &steady)
+    {
+        constexpr int attempts = 8;
+        uint64_t bestInterval = std::numeric_limits<uint64_t>::max();
+        uint64_t tsc = 0;
+        for (int attempt = 0; attempt < attempts; ++attempt)
+        {
+            uint64_t before = __rdtsc();
+            int64_t now = steadyNow();
+            uint64_t interval = __rdtsc() - before;
+            if (interval < bestInterval)
+            {
+                bestInterval = interval;
+                tsc = before + interval / 2;
+                steady = now;
+            }
+        }
+        return tsc;
+    };
+
+    res.tscBase = sample(res.steadyBase);
+    int64_t steadyEnd = 0;
+    uint64_t tscEnd = 0;
+    do
+    {
+        tscEnd = sample(steadyEnd);
+    }
+    while (steadyEnd - res.steadyBase < std::chrono::duration_cast<nanoseconds>(calibrationInterval).count());
+
+    uint64_t elapsedTicks = tscEnd - res.tscBase;
+    if (elapsedTicks == 0)
+    {
+        res.invariantTsc = false;
+        res.tscBase = uint64_t(res.steadyBase);
+        return res;
+    }
+    res.multiplier = uint64_t(((unsigned __int128)(steadyEnd - res.steadyBase) << 32) / elapsedTicks);
+#endif // TIMING_HAS_TSC
+    return res;
+}
+
+
+timing::LatencyHistogram::LatencyHistogram(size_t shardCount) :
+        _shardCount(shardCount != 0 ? shardCount : std::max(1u, std::thread::hardware_concurrency())),
+        _shards(new Shard[_shardCount])
+{
+    reset();
+}
+
+void timing::LatencyHistogram::record(uint64_t value) noexcept
+{
+    Shard &shard = threadShard();
+    shard.counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t current = shard.min.load(std::memory_order_relaxed);
+    while (value < current && !shard.min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    current = shard.max.load(std::memory_order_relaxed);
+    while (value > current && !shard.max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+timing::LatencyHistogram::Snapshot timing::LatencyHistogram::snapshot() const
+{
+    Snapshot res;
+    res._counts.assign(bucketCount, 0);
+    for (size_t i = 0; i < _shardCount; ++i)
+    {
+        const Shard &shard = _shards[i];
+        for (size_t bucket = 0; bucket < bucketCount; ++bucket)
+        {
+            uint64_t count = shard.counts[bucket].load(std::memory_order_relaxed);
+            res._counts[bucket] += count;
+            res._count += count;
+        }
+        res._sum += shard.sum.load(std::memory_order_relaxed);
+        res._min = std::min(res._min, shard.min.load(std::memory_order_relaxed));
+        res._max = std::max(res._max, shard.max.load(std::memory_order_relaxed));
+    }
+    return res;
+}
+
+void timing::LatencyHistogram::reset() noexcept
+{
+    for (size_t i = 0; i < _shardCount; ++i)
+    {
+        Shard &shard = _shards[i];
+        for (auto &count: shard.counts)
+            count.store(0, std::memory_order_relaxed);
+        shard.sum.store(0, std::memory_order_relaxed);
+        shard.min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        shard.max.store(0, std::memory_order_relaxed);
+    }
+}
+
+timing::LatencyHistogram::Shard &timing::LatencyHistogram::threadShard() noexcept
+{
+    static std::atomic<size_t> nextThread{0};
+    thread_local size_t thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return _shards[thread % _shardCount];
+}
+
+uint64_t timing::LatencyHistogram::Snapshot::percentileValue(double percent) const noexcept
+{
+    if (_count == 0)
+        return 0;
+    // NaN is treated as 0: converting it to integer is undefined
+    if (!(percent > 0))
+        return _min;
+    auto target = uint64_t(std::ceil(std::min(percent, 100.0) / 100.0 * double(_count)));
+    target = std::max<uint64_t>(target, 1);
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < _counts.size(); ++bucket)
+    {
+        seen += _counts[bucket];
+        if (seen >= target)
+            return std::max(_min, std::min(bucketUpperBound(bucket), _max));
+    }
+    return _max;
+}
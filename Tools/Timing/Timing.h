@@ -0,0 +1,354 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef EXPLORATIONS_TIMING_H
+#define EXPLORATIONS_TIMING_H
+
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <TimeConversion.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TIMING_HAS_TSC 1
+#else
+#define TIMING_HAS_TSC 0
+#endif // defined(__x86_64__) || defined(__i386__)
+
+
+namespace timing
+{
+    typedef timeConversion::TimeConverter::nanoseconds nanoseconds;
+
+    /*!
+     * @class TscClock
+     * Clock reading CPU time stamp counter, calibrated against std::chrono::steady_clock once on first use.
+     * Satisfies Clock requirements, so it can be used with std::chrono types
+     * @note Falls back to steady_clock if the CPU has no invariant TSC
+     */
+    class TscClock
+    {
+    public:
+        typedef nanoseconds duration;
+        typedef duration::rep rep;
+        typedef duration::period period;
+        typedef std::chrono::time_point<TscClock> time_point;
+        static constexpr bool is_steady = true;
+
+        /*!
+         * @struct Calibration
+         * Ticks to nanoseconds conversion: ns = steadyBase + ((ticks - tscBase) * multiplier >> 32)
+         */
+        struct Calibration
+        {
+            uint64_t tscBase;
+            int64_t steadyBase;
+            uint64_t multiplier;
+            bool invariantTsc;
+        };
+
+        /*!
+         * Read raw counter. Not serializing, so neighbouring instructions may be reordered around it
+         * @return Ticks of time stamp counter or steady_clock nanoseconds if TSC is unusable
+         */
+        static uint64_t ticks() noexcept;
+
+        /*!
+         * Convert ticks difference to duration
+         * @param ticks Ticks difference
+         * @return Duration in nanoseconds
+         */
+        static nanoseconds toDuration(uint64_t ticks) noexcept;
+
+        /*!
+         * Get current time. Time points share epoch with steady_clock
+         * @return Current time point
+         */
+        static time_point now() noexcept;
+
+        /*!
+         * Convert time point to steady_clock time point
+         */
+        static std::chrono::steady_clock::time_point toSteady(time_point time) noexcept;
+
+        /*!
+         * Get calibration, calibrating on the first call (takes about calibrationInterval)
+         * @return Calibration data
+         */
+        static const Calibration &calibration() noexcept;
+
+        /*!
+         * Time spent to calibrate the clock
+         */
+        static constexpr std::chrono::milliseconds calibrationInterval{10};
+
+    private:
+        static Calibration calibrate() noexcept;
+        static bool hasInvariantTsc() noexcept;
+    };
+
+
+    /*!
+     * @class Stopwatch
+     * Measures time elapsed since construction or the last restart
+     * @tparam Clock Clock to read time from
+     */
+    template<typename Clock = TscClock>
+    class Stopwatch
+    {
+        typename Clock::time_point _start;
+
+    public:
+        Stopwatch() noexcept : _start(Clock::now()) {}
+
+        /*!
+         * Get elapsed time
+         * @tparam T Type of returned duration
+         * @return Time elapsed since start
+         */
+        template<typename T = nanoseconds>
+        T elapsed() const noexcept;
+
+        /*!
+         * Start measuring again
+         * @tparam T Type of returned duration
+         * @return Time elapsed since previous start
+         */
+        template<typename T = nanoseconds>
+        T restart() noexcept;
+    };
+
+
+    /*!
+     * @class LatencyHistogram
+     * Lock-free log-linear (HDR-style) histogram of durations. Values below 2^subBucketBits nanoseconds are
+     * recorded exactly, larger ones with relative error below 2^-subBucketBits. Every thread records to its own
+     * shard (threads are spread over shards round-robin), shards are merged by snapshot
+     */
+    class LatencyHistogram
+    {
+    public:
+        static constexpr unsigned subBucketBits = 5;
+        static constexpr size_t subBucketCount = size_t(1) << subBucketBits;
+        static constexpr size_t bucketCount = (64 - subBucketBits + 1) * subBucketCount;
+
+        /*!
+         * @class Snapshot
+         * Merged state of all shards
+         */
+        class Snapshot
+        {
+            friend class LatencyHistogram;
+
+            std::vector<uint64_t> _counts;
+            uint64_t _count = 0;
+            uint64_t _sum = 0;
+            uint64_t _min = std::numeric_limits<uint64_t>::max();
+            uint64_t _max = 0;
+
+        public:
+            uint64_t count() const noexcept { return _count; }
+
+            /*!
+             * Get value at percentile: the smallest recorded value bucket covering percent of values
+             * @tparam T Type of returned duration (e.g. TimeConverter::microseconds), rounded up
+             * @param percent Percentile in range [0, 100]. Smaller values and NaN are treated as 0, larger as 100
+             * @return Upper bound of bucket, not greater than max. Zero if histogram is empty
+             */
+            template<typename T = nanoseconds>
+            T percentile(double percent) const noexcept;
+
+            template<typename T = nanoseconds>
+            T min() const noexcept { return std::chrono::ceil<T>(nanoseconds(_count == 0 ? 0 : _min)); }
+
+            template<typename T = nanoseconds>
+            T max() const noexcept { return std::chrono::ceil<T>(nanoseconds(_max)); }
+
+            template<typename T = nanoseconds>
+            T mean() const noexcept { return std::chrono::ceil<T>(nanoseconds(_count == 0 ? 0 : _sum / _count)); }
+
+        private:
+            uint64_t percentileValue(double percent) const noexcept;
+        };
+
+        /*!
+         * @param shardCount Count of shards. 0 means std::thread::hardware_concurrency()
+         */
+        explicit LatencyHistogram(size_t shardCount = 0);
+
+        /*!
+         * Record value
+         * @param value Value in nanoseconds
+         */
+        void record(uint64_t value) noexcept;
+
+        /*!
+         * Record duration. Negative durations are recorded as zero
+         */
+        template<typename Rep, typename Period>
+        void record(std::chrono::duration<Rep, Period> value) noexcept;
+
+        /*!
+         * Merge all shards. Concurrent records may be partially included
+         */
+        Snapshot snapshot() const;
+
+        /*!
+         * Shortcut for snapshot().percentile<T>(percent)
+         */
+        template<typename T = nanoseconds>
+        T percentile(double percent) const { return snapshot().percentile<T>(percent); }
+
+        /*!
+         * Remove all recorded values. Must not be called concurrently with record
+         */
+        void reset() noexcept;
+
+        /*!
+         * Get bucket index of value
+         */
+        static constexpr size_t bucketIndex(uint64_t value) noexcept;
+
+        /*!
+         * Get the largest value of bucket
+         */
+        static constexpr uint64_t bucketUpperBound(size_t index) noexcept;
+
+    private:
+        struct alignas(64) Shard
+        {
+            std::atomic<uint64_t> counts[bucketCount];
+            std::atomic<uint64_t> sum;
+            std::atomic<uint64_t> min;
+            std::atomic<uint64_t> max;
+        };
+
+        size_t _shardCount;
+        std::unique_ptr<Shard[]> _shards;
+
+        Shard &threadShard() noexcept;
+    };
+
+
+    /*!
+     * @class ScopedStopwatch
+     * Records time spent in scope to histogram on destruction
+     * @tparam Clock Clock to read time from
+     */
+    template<typename Clock = TscClock>
+    class ScopedStopwatch
+    {
+        LatencyHistogram &_histogram;
+        Stopwatch<Clock> _stopwatch;
+
+    public:
+        explicit ScopedStopwatch(LatencyHistogram &histogram) noexcept : _histogram(histogram) {}
+        ScopedStopwatch(const ScopedStopwatch &) = delete;
+        ScopedStopwatch &operator=(const ScopedStopwatch &) = delete;
+        ~ScopedStopwatch() { _histogram.record(_stopwatch.elapsed()); }
+    };
+}
+
+
+inline uint64_t timing::TscClock::ticks() noexcept
+{
+#if TIMING_HAS_TSC
+    if (calibration().invariantTsc)
+        return __rdtsc();
+#endif // TIMING_HAS_TSC
+    return uint64_t(std::chrono::duration_cast<nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline timing::nanoseconds timing::TscClock::toDuration(uint64_t ticks) noexcept
+{
+    return nanoseconds(int64_t((unsigned __int128)ticks * calibration().multiplier >> 32));
+}
+
+inline timing::TscClock::time_point timing::TscClock::now() noexcept
+{
+    const Calibration &current = calibration();
+    return time_point(nanoseconds(current.steadyBase) + toDuration(ticks() - current.tscBase));
+}
+
+inline std::chrono::steady_clock::time_point timing::TscClock::toSteady(time_point time) noexcept
+{
+    return std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(time.time_since_epoch()));
+}
+
+inline const timing::TscClock::Calibration &timing::TscClock::calibration() noexcept
+{
+    static const Calibration current = calibrate();
+    return current;
+}
+
+
+template<typename Clock>
+template<typename T>
+T timing::Stopwatch<Clock>::elapsed() const noexcept
+{
+    return std::chrono::duration_cast<T>(Clock::now() - _start);
+}
+
+template<typename Clock>
+template<typename T>
+T timing::Stopwatch<Clock>::restart() noexcept
+{
+    auto now = Clock::now();
+    auto res = std::chrono::duration_cast<T>(now - _start);
+    _start = now;
+    return res;
+}
+
+
+template<typename T>
+T timing::LatencyHistogram::Snapshot::percentile(double percent) const noexcept
+{
+    static_assert(timeConversion::TimeConverter::is_duration_v<T>, "Type must be duration");
+    return std::chrono::ceil<T>(nanoseconds(percentileValue(percent)));
+}
+
+template<typename Rep, typename Period>
+void timing::LatencyHistogram::record(std::chrono::duration<Rep, Period> value) noexcept
+{
+    auto count = std::chrono::duration_cast<nanoseconds>(value).count();
+    record(count < 0 ? uint64_t(0) : uint64_t(count));
+}
+
+constexpr size_t timing::LatencyHistogram::bucketIndex(uint64_t value) noexcept
+{
+    if (value < subBucketCount)
+        return size_t(value);
+    unsigned shift = unsigned(63 - __builtin_clzll(value)) - subBucketBits;
+    return (size_t(shift) + 1) * subBucketCount + size_t((value >> shift) - subBucketCount);
+}
+
+constexpr uint64_t timing::LatencyHistogram::bucketUpperBound(size_t index) noexcept
+{
+    if (index < subBucketCount)
+        return index;
+    unsigned shift = unsigned(index / subBucketCount) - 1;
+    uint64_t lower = (uint64_t(subBucketCount) + index % subBucketCount) << shift;
+    return lower + ((uint64_t(1) << shift) - 1);
+}
+
+#endif //EXPLORATIONS_TIMING_H
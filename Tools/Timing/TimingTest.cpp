@@ -0,0 +1,140 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include <Timing.h>
+#include <TestsPreparations.h>
+#include <thread>
+#include <cmath>
+
+#define DURATION timeConversion::TimeConverter
+
+
+TEST_CASE("Timing")
+{
+    SECTION("TscClock")
+    {
+        REQUIRE(timing::TscClock::calibration().multiplier != 0);
+        auto steadyBefore = std::chrono::steady_clock::now();
+        auto tscBefore = timing::TscClock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        auto tscAfter = timing::TscClock::now();
+        auto steadyAfter = std::chrono::steady_clock::now();
+
+        REQUIRE(tscAfter >= tscBefore);
+        auto tscElapsed = tscAfter - tscBefore;
+        auto steadyElapsed = steadyAfter - steadyBefore;
+        REQUIRE(tscElapsed >= std::chrono::milliseconds(19));
+        REQUIRE(tscElapsed <= steadyElapsed + std::chrono::milliseconds(1));
+        auto difference = timing::TscClock::toSteady(tscAfter) - steadyAfter;
+        REQUIRE(std::chrono::abs(difference) < std::chrono::milliseconds(5));
+    }
+
+    SECTION("Stopwatch")
+    {
+        timing::Stopwatch<> stopwatch;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        REQUIRE(stopwatch.elapsed<DURATION::microseconds>() >= DURATION::microseconds(4900));
+        REQUIRE(stopwatch.restart<DURATION::milliseconds>() >= DURATION::milliseconds(4));
+        REQUIRE(stopwatch.elapsed() < DURATION::milliseconds(4));
+
+        timing::Stopwatch<std::chrono::steady_clock> steadyStopwatch;
+        REQUIRE(steadyStopwatch.elapsed() >= DURATION::nanoseconds(0));
+    }
+
+    SECTION("Buckets")
+    {
+        for (uint64_t value = 0; value < timing::LatencyHistogram::subBucketCount * 4; ++value)
+        {
+            size_t index = timing::LatencyHistogram::bucketIndex(value);
+            REQUIRE(timing::LatencyHistogram::bucketUpperBound(index) >= value);
+            REQUIRE((index == 0 || timing::LatencyHistogram::bucketUpperBound(index - 1) < value));
+        }
+        for (uint64_t value: {uint64_t(1000), uint64_t(123456789), uint64_t(1) << 40, UINT64_MAX})
+        {
+            size_t index = timing::LatencyHistogram::bucketIndex(value);
+            REQUIRE(index < timing::LatencyHistogram::bucketCount);
+            uint64_t upper = timing::LatencyHistogram::bucketUpperBound(index);
+            REQUIRE(upper >= value);
+            REQUIRE(double(upper - value) <= double(value) / timing::LatencyHistogram::subBucketCount);
+        }
+        REQUIRE(timing::LatencyHistogram::bucketIndex(UINT64_MAX) == timing::LatencyHistogram::bucketCount - 1);
+    }
+
+    SECTION("Percentiles")
+    {
+        timing::LatencyHistogram histogram(4);
+        REQUIRE(histogram.percentile(50) == DURATION::nanoseconds(0));
+        for (uint64_t value = 1; value <= 1000; ++value)
+            histogram.record(DURATION::microseconds(value));
+
+        auto snapshot = histogram.snapshot();
+        REQUIRE(snapshot.count() == 1000);
+        REQUIRE(snapshot.min() == DURATION::microseconds(1));
+        REQUIRE(snapshot.max() == DURATION::microseconds(1000));
+        REQUIRE(snapshot.mean<DURATION::microseconds>() == DURATION::microseconds(501));
+        REQUIRE(snapshot.percentile(0) == DURATION::microseconds(1));
+        REQUIRE(snapshot.percentile(100) == DURATION::microseconds(1000));
+        REQUIRE(snapshot.percentile(-5) == DURATION::microseconds(1));
+        REQUIRE(snapshot.percentile(std::nan("")) == DURATION::microseconds(1));
+        REQUIRE(snapshot.percentile(std::numeric_limits<double>::infinity()) == DURATION::microseconds(1000));
+        auto median = snapshot.percentile<DURATION::microseconds>(50);
+        REQUIRE(median >= DURATION::microseconds(500));
+        REQUIRE(median <= DURATION::microseconds(500 + 500 / 32 + 1));
+        auto p99 = snapshot.percentile(99.9);
+        REQUIRE(p99 >= DURATION::microseconds(999));
+        REQUIRE(p99 <= DURATION::microseconds(1000));
+
+        histogram.record(DURATION::seconds(-1));
+        REQUIRE(histogram.snapshot().min() == DURATION::nanoseconds(0));
+        histogram.reset();
+        REQUIRE(histogram.snapshot().count() == 0);
+    }
+
+    SECTION("Concurrent")
+    {
+        timing::LatencyHistogram histogram(3);
+        std::vector<std::thread> threads;
+        for (uint64_t thread = 0; thread < 8; ++thread)
+        {
+            threads.emplace_back([&histogram, thread]()
+            {
+                for (uint64_t value = 0; value < 10000; ++value)
+                    histogram.record(thread * 10000 + value);
+            });
+        }
+        for (auto &thread: threads)
+            thread.join();
+        auto snapshot = histogram.snapshot();
+        REQUIRE(snapshot.count() == 80000);
+        REQUIRE(snapshot.min() == DURATION::nanoseconds(0));
+        REQUIRE(snapshot.max() == DURATION::nanoseconds(79999));
+        REQUIRE(snapshot.mean() == DURATION::nanoseconds(39999));
+    }
+
+    SECTION("ScopedStopwatch")
+    {
+        timing::LatencyHistogram histogram(1);
+        for (int i = 0; i < 3; ++i)
+        {
+            timing::ScopedStopwatch<> stopwatch(histogram);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto snapshot = histogram.snapshot();
+        REQUIRE(snapshot.count() == 3);
+        REQUIRE(snapshot.min<DURATION::microseconds>() >= DURATION::microseconds(900));
+    }
+}
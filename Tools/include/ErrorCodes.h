@@ -31,7 +31,9 @@ namespace Parse
         GlibError = 4,                ///< Glib error occurred
         FileNotLoaded = 5,            ///< Config file isn't loaded
         IncorrectFileContainment = 6, ///< File consists element(-s) which can't be parsed
-        OutOfRange = 7                ///< Tried to parse value which is larger than type can contain
+        OutOfRange = 7,               ///< Tried to parse value which is larger than type can contain
+        SaveFailed = 8,               ///< Config file wasn't saved correctly
+        ConstraintViolated = 9        ///< Parsed value doesn't satisfy registered constraint
     };
 }
 
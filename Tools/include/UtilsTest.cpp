@@ -0,0 +1,212 @@
+// AdditionalCodeTools. Support tools for main code.
+// Copyright (C) 2019 Evgeny Zaytsev
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include <TestsPreparations.h>
+#include <utils.h>
+
+
+TEST_CASE("UtilsTest")
+{
+    SECTION("Add")
+    {
+        int8_t value = 100;
+        REQUIRE(Utils::checkAddOverflow(&value, 27));
+        REQUIRE(value == 127);
+        REQUIRE(!Utils::checkAddOverflow(&value, 1));
+        REQUIRE(value == 127);
+        value = -100;
+        REQUIRE(Utils::checkAddOverflow(&value, -28));
+        REQUIRE(value == -128);
+        REQUIRE(!Utils::checkAddOverflow(&value, -1));
+        REQUIRE(value == -128);
+
+        uint64_t unsignedValue = std::numeric_limits<uint64_t>::max() - 1;
+        REQUIRE(Utils::checkAddOverflow(&unsignedValue, 1u));
+        REQUIRE(!Utils::checkAddOverflow(&unsignedValue, 1u));
+        REQUIRE(unsignedValue == std::numeric_limits<uint64_t>::max());
+        unsignedValue = 1;
+        REQUIRE(!Utils::checkAddOverflow(&unsignedValue, -2));
+        REQUIRE(Utils::checkAddOverflow(&unsignedValue, -1));
+        REQUIRE(unsignedValue == 0);
+    }
+
+    SECTION("Subtract")
+    {
+        int16_t value = -32767;
+        REQUIRE(Utils::checkSubtractOverflow(&value, 1));
+        REQUIRE(value == std::numeric_limits<int16_t>::min());
+        REQUIRE(!Utils::checkSubtractOverflow(&value, 1));
+        REQUIRE(value == std::numeric_limits<int16_t>::min());
+        value = 32766;
+        REQUIRE(Utils::checkSubtractOverflow(&value, -1));
+        REQUIRE(!Utils::checkSubtractOverflow(&value, -1));
+        REQUIRE(value == std::numeric_limits<int16_t>::max());
+
+        uint32_t unsignedValue = 1;
+        REQUIRE(Utils::checkSubtractOverflow(&unsignedValue, 1u));
+        REQUIRE(!Utils::checkSubtractOverflow(&unsignedValue, 1u));
+        REQUIRE(unsignedValue == 0);
+    }
+
+    SECTION("Multiply")
+    {
+        int32_t value = 1 << 30;
+        REQUIRE(!Utils::checkMultiplyOverflow(&value, 2));
+        REQUIRE(value == 1 << 30);
+        REQUIRE(Utils::checkMultiplyOverflow(&value, -2));
+        REQUIRE(value == std::numeric_limits<int32_t>::min());
+        REQUIRE(!Utils::checkMultiplyOverflow(&value, -1));
+        REQUIRE(value == std::numeric_limits<int32_t>::min());
+
+        uint8_t unsignedValue = 85;
+        REQUIRE(Utils::checkMultiplyOverflow(&unsignedValue, 3u));
+        REQUIRE(unsignedValue == 255);
+        REQUIRE(!Utils::checkMultiplyOverflow(&unsignedValue, 2u));
+        REQUIRE(!Utils::checkMultiplyOverflow(&unsignedValue, -1));
+        REQUIRE(unsignedValue == 255);
+    }
+
+    SECTION("MultiplyByFloating")
+    {
+        uint64_t unsignedValue = 10;
+        REQUIRE(!Utils::checkMultiplyOverflow(&unsignedValue, -1.0));
+        REQUIRE(!Utils::checkMultiplyOverflow(&unsignedValue, -0.5));
+        REQUIRE(unsignedValue == 10);
+        REQUIRE(Utils::checkMultiplyOverflow(&unsignedValue, 1.5));
+        REQUIRE(unsignedValue == 15);
+
+        // 2^64 is the first value out of range, the greatest double below it is 2^64 - 2^11
+        unsignedValue = 1ull << 63;
+        REQUIRE(!Utils::checkMultiplyOverflow(&unsignedValue, 2.0));
+        REQUIRE(unsignedValue == 1ull << 63);
+        REQUIRE(Utils::checkMultiplyOverflow(&unsignedValue, 2.0 - std::ldexp(1.0, -52)));
+        REQUIRE(unsignedValue == std::numeric_limits<uint64_t>::max() - 2047);
+
+        int64_t value = 1ll << 62;
+        REQUIRE(!Utils::checkMultiplyOverflow(&value, 2.0));
+        REQUIRE(value == 1ll << 62);
+        REQUIRE(Utils::checkMultiplyOverflow(&value, -2.0));
+        REQUIRE(value == std::numeric_limits<int64_t>::min());
+        value = 1ll << 62;
+        REQUIRE(!Utils::checkMultiplyOverflow(&value, -2.0 - std::ldexp(1.0, -51)));
+        REQUIRE(value == 1ll << 62);
+        REQUIRE(!Utils::checkMultiplyOverflow(&value, std::numeric_limits<double>::quiet_NaN()));
+        REQUIRE(!Utils::checkMultiplyOverflow(&value, std::numeric_limits<double>::infinity()));
+        REQUIRE(value == 1ll << 62);
+
+        int8_t smallValue = 64;
+        REQUIRE(!Utils::checkMultiplyOverflow(&smallValue, 2.0f));
+        REQUIRE(Utils::checkMultiplyOverflow(&smallValue, -2.0f));
+        REQUIRE(smallValue == -128);
+
+        double floatingValue = std::numeric_limits<double>::max();
+        REQUIRE(!Utils::checkMultiplyOverflow(&floatingValue, 2));
+        REQUIRE(!Utils::checkMultiplyOverflow(&floatingValue, -2));
+        REQUIRE(Utils::checkMultiplyOverflow(&floatingValue, -1));
+        REQUIRE(floatingValue == std::numeric_limits<double>::lowest());
+    }
+
+    SECTION("Shift")
+    {
+        int32_t value = 1;
+        REQUIRE(Utils::checkShiftOverflow(&value, 30));
+        REQUIRE(value == 1 << 30);
+        REQUIRE(!Utils::checkShiftOverflow(&value, 1));
+        REQUIRE(value == 1 << 30);
+
+        uint64_t unsignedValue = 1;
+        REQUIRE(Utils::checkShiftOverflow(&unsignedValue, 63));
+        REQUIRE(unsignedValue == 1ull << 63);
+        REQUIRE(!Utils::checkShiftOverflow(&unsignedValue, 1));
+        REQUIRE(!Utils::checkShiftOverflow(&unsignedValue, 64));
+        REQUIRE(unsignedValue == 1ull << 63);
+        unsignedValue = 0;
+        REQUIRE(Utils::checkShiftOverflow(&unsignedValue, 64));
+        REQUIRE(Utils::checkShiftOverflow(&unsignedValue, 1000));
+        REQUIRE(unsignedValue == 0);
+    }
+
+    SECTION("Cast")
+    {
+        uint8_t result = 0;
+        REQUIRE(Utils::checkCastOverflow(&result, 255));
+        REQUIRE(result == 255);
+        REQUIRE(!Utils::checkCastOverflow(&result, 256));
+        REQUIRE(!Utils::checkCastOverflow(&result, -1));
+        REQUIRE(result == 255);
+
+        int32_t signedResult = 0;
+        REQUIRE(Utils::checkCastOverflow(&signedResult, int64_t(std::numeric_limits<int32_t>::min())));
+        REQUIRE(signedResult == std::numeric_limits<int32_t>::min());
+        REQUIRE(!Utils::checkCastOverflow(&signedResult, int64_t(std::numeric_limits<int32_t>::min()) - 1));
+        REQUIRE(!Utils::checkCastOverflow(&signedResult, uint32_t(1) << 31));
+        REQUIRE(Utils::checkCastOverflow(&signedResult, (uint32_t(1) << 31) - 1));
+        REQUIRE(signedResult == std::numeric_limits<int32_t>::max());
+    }
+
+    SECTION("Batch")
+    {
+        int8_t values[4] = {0, 100, -100, 127};
+        const int8_t addends[4] = {1, 27, -28, 0};
+        REQUIRE(Utils::checkAddOverflow(values, addends, 4));
+        REQUIRE(values[1] == 127);
+        REQUIRE(values[2] == -128);
+        REQUIRE(!Utils::checkAddOverflow(values, addends, 4));
+        int8_t subtrahends[4] = {-127, 0, 0, 0};
+        values[0] = 0;
+        REQUIRE(Utils::checkSubtractOverflow(values, subtrahends, 1));
+        REQUIRE(values[0] == 127);
+        REQUIRE(!Utils::checkSubtractOverflow(values, subtrahends, 1));
+        values[0] = -1;
+        subtrahends[0] = 127;
+        REQUIRE(Utils::checkSubtractOverflow(values, subtrahends, 1));
+        REQUIRE(values[0] == -128);
+        REQUIRE(!Utils::checkSubtractOverflow(values, subtrahends, 1));
+
+        uint32_t unsignedValues[3] = {1, 1u << 16, 0xFFFF};
+        const uint32_t multipliers[3] = {0xFFFFFFFF, 0xFFFF, 0x10001};
+        REQUIRE(Utils::checkMultiplyOverflow(unsignedValues, multipliers, 3));
+        REQUIRE(unsignedValues[0] == 0xFFFFFFFF);
+        REQUIRE(unsignedValues[1] == 0xFFFF0000);
+        REQUIRE(unsignedValues[2] == 0xFFFFFFFF);
+        REQUIRE(!Utils::checkMultiplyOverflow(unsignedValues, multipliers, 3));
+
+        uint16_t shortValues[3] = {1, 0x7FFF, 0};
+        REQUIRE(Utils::checkMultiplyOverflow(shortValues, 3, 2u));
+        REQUIRE(shortValues[1] == 0xFFFE);
+        REQUIRE(!Utils::checkMultiplyOverflow(shortValues, 3, 2u));
+        shortValues[0] = 1;
+        shortValues[1] = 0;
+        REQUIRE(Utils::checkShiftOverflow(shortValues, 2, 15));
+        REQUIRE(shortValues[0] == 0x8000);
+        REQUIRE(!Utils::checkShiftOverflow(shortValues, 2, 1));
+        shortValues[0] = 1;
+        REQUIRE(!Utils::checkShiftOverflow(shortValues, 2, 16));
+        shortValues[0] = 0;
+        REQUIRE(Utils::checkShiftOverflow(shortValues, 3, 16));
+
+        const int64_t wideValues[3] = {-128, 127, 0};
+        int8_t narrowValues[3] = {};
+        REQUIRE(Utils::checkCastOverflow(narrowValues, wideValues, 3));
+        REQUIRE(narrowValues[0] == -128);
+        REQUIRE(narrowValues[1] == 127);
+        const int64_t outOfRange[2] = {0, 128};
+        REQUIRE(!Utils::checkCastOverflow(narrowValues, outOfRange, 2));
+        const int64_t negative[2] = {-1, 0};
+        uint8_t unsignedNarrow[2] = {};
+        REQUIRE(!Utils::checkCastOverflow(unsignedNarrow, negative, 2));
+    }
+}
@@ -19,6 +19,9 @@
 
 #include <cmath>
 #include <cinttypes>
+#include <cassert>
+#include <limits>
+#include <type_traits>
 
 
 namespace Utils
@@ -58,6 +61,57 @@ namespace Utils
     }
 
 
+    /*!
+     * Checked arithmetic. Scalar functions apply operation to value only if the result fits into its type and
+     * return true, otherwise leave value unchanged and return false. Batch functions apply operation to count
+     * values without branches, so loops can be vectorized, and return false if any of results overflowed. Values
+     * are unspecified in that case (overflowed results are wrapped)
+     */
+
+    /*!
+     * Check addition for overflow
+     * @tparam T Type of result and value
+     * @tparam U Type of addend
+     * @param value Pointer to value to be increased
+     * @param addend Addend
+     * @retval true Success, added
+     * @retval false Overflow will be occurred, not added
+     */
+    template<typename T, typename U>
+    constexpr bool checkAddOverflow(T *value, U addend)
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<U>, "Types should be integral");
+        assert(value != nullptr);
+
+        T res = 0;
+        if (__builtin_add_overflow(*value, addend, &res))
+            return false;
+        *value = res;
+        return true;
+    }
+
+    /*!
+     * Check subtraction for overflow
+     * @tparam T Type of result and value
+     * @tparam U Type of subtrahend
+     * @param value Pointer to value to be decreased
+     * @param subtrahend Subtrahend
+     * @retval true Success, subtracted
+     * @retval false Overflow will be occurred, not subtracted
+     */
+    template<typename T, typename U>
+    constexpr bool checkSubtractOverflow(T *value, U subtrahend)
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<U>, "Types should be integral");
+        assert(value != nullptr);
+
+        T res = 0;
+        if (__builtin_sub_overflow(*value, subtrahend, &res))
+            return false;
+        *value = res;
+        return true;
+    }
+
     /*!
      * Check multiplication for overflow
      * @tparam T Type of result and first multiplier
@@ -68,32 +122,216 @@ namespace Utils
      * @retval false Overflow will be occurred, not multiplied
      */
     template<typename T, typename U>
-    bool checkMultiplyOverflow(T *value, U multiplier)
+    constexpr bool checkMultiplyOverflow(T *value, U multiplier)
     {
         static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>, "Types should be arithmetic");
         assert(value != nullptr);
 
-        if (multiplier == 1)
-            return true;
-        if (std::is_unsigned_v<T> && multiplier < 0)
-            return false;
-        if constexpr (std::is_unsigned_v<T> && std::is_unsigned_v<U>)
+        if constexpr (std::is_integral_v<T> && std::is_integral_v<U>)
         {
-            if (divideAndRoundUp<std::uintmax_t>(std::numeric_limits<T>::max(), multiplier) <= *value)
+            T res = 0;
+            if (__builtin_mul_overflow(*value, multiplier, &res))
                 return false;
+            *value = res;
         }
         else
         {
-            if (std::is_unsigned_v<T> &&
-                abs(divideAndRoundUp<uintmax_t>(std::numeric_limits<T>::max(), multiplier)) <= uintmax_t(abs(*value)))
-                return false;
-            else if (abs(divideAndRoundUp<intmax_t>(std::numeric_limits<T>::max(), multiplier)) <=
-                     intmax_t(abs(*value)))
+            if constexpr (std::is_unsigned_v<T> && !std::is_unsigned_v<U>)
+            {
+                if (multiplier < 0)
+                    return false;
+            }
+            auto res = *value * multiplier;
+            if constexpr (std::is_integral_v<T>)
+            {
+                // 2^digits and min() are exact in floating point, unlike max()
+                constexpr auto upperBound = decltype(res)(std::numeric_limits<T>::max() / 2 + 1) * 2;
+                if (!(res < upperBound) || !(res >= decltype(res)(std::numeric_limits<T>::min())))
+                    return false;
+            }
+            else if (!(std::abs(res) <= std::numeric_limits<T>::max()))
                 return false;
+            *value = T(res);
         }
-        *value = T(*value * multiplier);
         return true;
     }
+
+    /*!
+     * Check left shift for overflow
+     * @tparam T Type of value
+     * @param value Pointer to value to be shifted
+     * @param shift Count of bits to shift value by
+     * @retval true Success, shifted (multiplied by 2^shift)
+     * @retval false Overflow will be occurred or shift is not less than count of value bits, not shifted
+     */
+    template<typename T>
+    constexpr bool checkShiftOverflow(T *value, unsigned shift)
+    {
+        static_assert(std::is_integral_v<T>, "Type should be integral");
+        assert(value != nullptr);
+
+        if (shift >= unsigned(std::numeric_limits<T>::digits))
+            return *value == 0;
+        return checkMultiplyOverflow(value, T(T(1) << shift));
+    }
+
+    /*!
+     * Check conversion for overflow
+     * @tparam T Type of result
+     * @tparam U Type of value
+     * @param result Pointer to store converted value to
+     * @param value Value to be converted
+     * @retval true Success, value is representable in T and stored to result
+     * @retval false Value is out of T range, result is not changed
+     */
+    template<typename T, typename U>
+    constexpr bool checkCastOverflow(T *result, U value)
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<U>, "Types should be integral");
+        assert(result != nullptr);
+
+        T res = 0;
+        if (__builtin_add_overflow(value, U(0), &res))
+            return false;
+        *result = res;
+        return true;
+    }
+
+    /*!
+     * Add operands to values element-wise (see checked arithmetic)
+     * @return false if any of results overflowed, true otherwise
+     */
+    template<typename T, typename U>
+    constexpr bool checkAddOverflow(T *values, const U *operands, size_t count)
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<U>, "Types should be integral");
+        bool overflow = false;
+        for (size_t i = 0; i < count; ++i)
+            overflow |= __builtin_add_overflow(values[i], operands[i], &values[i]);
+        return !overflow;
+    }
+
+    /*!
+     * Subtract operands from values element-wise (see checked arithmetic)
+     * @return false if any of results overflowed, true otherwise
+     */
+    template<typename T, typename U>
+    constexpr bool checkSubtractOverflow(T *values, const U *operands, size_t count)
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<U>, "Types should be integral");
+        bool overflow = false;
+        for (size_t i = 0; i < count; ++i)
+            overflow |= __builtin_sub_overflow(values[i], operands[i], &values[i]);
+        return !overflow;
+    }
+
+    /*!
+     * Multiply values by operands element-wise (see checked arithmetic)
+     * @return false if any of results overflowed, true otherwise
+     */
+    template<typename T, typename U>
+    constexpr bool checkMultiplyOverflow(T *values, const U *operands, size_t count)
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<U>, "Types should be integral");
+        bool overflow = false;
+        for (size_t i = 0; i < count; ++i)
+            overflow |= __builtin_mul_overflow(values[i], operands[i], &values[i]);
+        return !overflow;
+    }
+
+    /*!
+     * Multiply all values by the same multiplier (see checked arithmetic)
+     * @return false if any of results overflowed, true otherwise
+     */
+    template<typename T, typename U>
+    constexpr bool checkMultiplyOverflow(T *values, size_t count, U multiplier)
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<U>, "Types should be integral");
+        bool overflow = false;
+        for (size_t i = 0; i < count; ++i)
+            overflow |= __builtin_mul_overflow(values[i], multiplier, &values[i]);
+        return !overflow;
+    }
+
+    /*!
+     * Shift all values left by the same count of bits (see checked arithmetic)
+     * @return false if any of results overflowed or shift is not less than count of value bits, true otherwise
+     */
+    template<typename T>
+    constexpr bool checkShiftOverflow(T *values, size_t count, unsigned shift)
+    {
+        static_assert(std::is_integral_v<T>, "Type should be integral");
+        if (shift >= unsigned(std::numeric_limits<T>::digits))
+        {
+            bool nonZero = false;
+            for (size_t i = 0; i < count; ++i)
+                nonZero |= values[i] != 0;
+            return !nonZero;
+        }
+        return checkMultiplyOverflow(values, count, T(T(1) << shift));
+    }
+
+    /*!
+     * Convert values element-wise (see checked arithmetic)
+     * @return false if any of values is out of T range, true otherwise
+     */
+    template<typename T, typename U>
+    constexpr bool checkCastOverflow(T *results, const U *values, size_t count)
+    {
+        static_assert(std::is_integral_v<T> && std::is_integral_v<U>, "Types should be integral");
+        bool overflow = false;
+        for (size_t i = 0; i < count; ++i)
+            overflow |= __builtin_add_overflow(values[i], U(0), &results[i]);
+        return !overflow;
+    }
+
+
+    /*!
+     * Count decimal digits of value
+     * @param value Value to count digits of
+     * @return Digits count (1 for 0)
+     */
+    constexpr unsigned decimalDigits(uint64_t value) noexcept
+    {
+        unsigned digits = 1;
+        for (; value >= 10000; value /= 10000)
+            digits += 4;
+        return digits + (value >= 10) + (value >= 100) + (value >= 1000);
+    }
+
+
+    /*!
+     * Write decimal representation of value to buffer using two-digit table. Doesn't write terminating null
+     * @param buffer Buffer of at least decimalDigits(value) symbols (20 is always enough)
+     * @param value Value to be written
+     * @return Pointer to the symbol after the last written one
+     */
+    inline char *writeUnsigned(char *buffer, uint64_t value) noexcept
+    {
+        constexpr char digitPairs[] =
+                "0001020304050607080910111213141516171819"
+                "2021222324252627282930313233343536373839"
+                "4041424344454647484950515253545556575859"
+                "6061626364656667686970717273747576777879"
+                "8081828384858687888990919293949596979899";
+        char *end = buffer + decimalDigits(value);
+        char *pos = end;
+        for (; value >= 100; value /= 100)
+        {
+            pos -= 2;
+            pos[0] = digitPairs[(value % 100) * 2];
+            pos[1] = digitPairs[(value % 100) * 2 + 1];
+        }
+        if (value >= 10)
+        {
+            pos -= 2;
+            pos[0] = digitPairs[value * 2];
+            pos[1] = digitPairs[value * 2 + 1];
+        }
+        else
+            *--pos = char('0' + value);
+        return end;
+    }
 }
 
 #endif //EXPLORATIONS_UTILS_H